@@ -86,19 +86,23 @@ def main():
 <h2>Notes</h2>
 
 <ul>
-  <li>Layer keys are labeled e.g. <code>la 2 +- 2</code>
+  <li>Layer keys are labeled e.g. <code>la 2 +-</code>
   <ul>
 	<li><code>la</code> is for "layer"</li>
-	<li><code>2</code> indicates that the second pair of push|pop functions is
-	being used (differently numbered pairs won't interfere with each
-	other)</li>
+	<li><code>2</code> indicates the layer-number that the key acts on (keys
+	for different layers won't interfere with each other)</li>
 	<li><code>+</code> indicates that the layer is being "pushed" onto the
 	stack at some point, either when the key is pressed or when it is
 	released</li>
 	<li><code>-</code> indicates that the layer is being "popped" off of the
 	stack at some point</li>
-	<li>the last <code>2</code> indicates the layer-number that will be
-	activated on "push".</li>
+	<li><code>st</code> indicates a "sticky" key: the layer is active while
+	the key is held, or (tapped once) for the next key only, or (tapped
+	twice) until the key is pressed again</li>
+	<li><code>tg</code> indicates that the layer is pushed on one press, and
+	popped on the next</li>
+	<li><code>la all -</code> pops every layer off of the stack, leaving only
+	layer 0</li>
   </ul>
   See the project 'readme.md' file on <a
   href='https://github.com/benblazak/ergodox-firmware'>the github page</a> as a
@@ -156,13 +160,19 @@ def main():
 				replace = '(null)'
 			elif re.search(r'numpad', press+release):
 				replace = '[num]'
+			elif re.search(r'layer_pop_all', press+release):
+				replace = 'la all -'
 			elif re.search(r'layer', press+release):
-				replace = 'la ' + re.findall(r'\d+', press+release)[0] + ' '
-				if re.search(r'push', press+release):
-					replace += '+'
-				if re.search(r'pop', press+release):
-					replace += '-'
-				replace += ' ' + str(code)
+				replace = 'la ' + str(code) + ' '
+				if re.search(r'sticky', press+release):
+					replace += 'st'
+				elif re.search(r'toggle', press+release):
+					replace += 'tg'
+				else:
+					if re.search(r'push', press+release):
+						replace += '+'
+					if re.search(r'pop', press+release):
+						replace += '-'
 			else:
 				replace = keycode_to_string.get(code, '[n/a]')
 
@@ -0,0 +1,195 @@
+#! /usr/bin/env python3
+# -----------------------------------------------------------------------------
+# Copyright (c) 2026 The ergodox-firmware contributors
+# Released under The MIT License (MIT) (see "license.md")
+# Project located at <https://github.com/benblazak/ergodox-firmware>
+# -----------------------------------------------------------------------------
+
+"""
+Generate the sparse form of a layout (a C header, to be included at the end of
+the layout's '.c')
+
+Depends on:
+- the matrix file (for the order of the arguments to 'KB_MATRIX_LAYER')
+- the layout file (for the '_kb_layout' matrix)
+
+For each layer, the most common action becomes that layer's 'fill'.  Only keys
+with some other action get an entry; which ones those are is kept as a bitmap
+per row (see "src/keyboard/ergodox/layout/default--matrix-control.h").
+Actions are compared (and copied) as text, so they're written out exactly as
+they are in the layout.
+"""
+
+# -----------------------------------------------------------------------------
+
+import argparse
+import os
+import re
+import sys
+
+# -----------------------------------------------------------------------------
+
+def strip_comments(text):
+	text = re.sub(r'/\*.*?\*/', ' ', text, flags=re.DOTALL)
+	text = re.sub(r'//[^\n]*', ' ', text)
+	return text
+
+def split_arguments(text, start):
+	"""
+	Split the (comma separated) arguments of the call whose opening '(' is at
+	'start'; return them, and the position just after the closing ')'
+	"""
+	arguments = []
+	depth = 0
+	current = ''
+	for i in range(start, len(text)):
+		char = text[i]
+		if char in '({[':
+			depth += 1
+			if depth == 1:
+				continue
+		elif char in ')}]':
+			depth -= 1
+			if depth == 0:
+				arguments.append(current)
+				return ([' '.join(a.split()) for a in arguments], i+1)
+		elif char == ',' and depth == 1:
+			arguments.append(current)
+			current = ''
+			continue
+		current += char
+	raise ValueError("unbalanced parentheses")
+
+# -----------------------------------------------------------------------------
+
+def parse_matrix_file(matrix_file_path):
+	"""
+	Return a list of (row, column) for each argument to 'KB_MATRIX_LAYER'
+	"""
+	text = strip_comments(open(matrix_file_path).read()).replace('\\\n', ' ')
+	match = re.search(
+			r'#define\s+KB_MATRIX_LAYER\s*\(([^)]+)\)\s*\{\{(.+?)\}\}',
+			text, flags=re.DOTALL )
+	parameters = [p.strip() for p in match.group(1).split(',')]
+	rows = [ [k.strip() for k in row.split(',')]
+	         for row in re.split(r'\}\s*,\s*\{', match.group(2)) ]
+
+	positions = {}
+	for (r, row) in enumerate(rows):
+		for (c, name) in enumerate(row):
+			positions.setdefault(name, []).append((r, c))
+
+	return ( len(rows), len(rows[0]),
+	         [positions.get(p, []) for p in parameters] )
+
+def parse_layout_file(layout_file_path, rows, columns, positions):
+	"""
+	Return the '_kb_layout' matrix, as a list of layers of rows of actions
+	(as text)
+	"""
+	text = strip_comments(open(layout_file_path).read())
+	match = re.search(r'\b_kb_layout\s*\[[^=]*=\s*\{', text)
+	if not match:
+		raise ValueError("'_kb_layout' not found")
+	(body, _) = split_arguments(text, match.end()-1)
+	body = ','.join(body)
+
+	layers = []
+	for match in re.finditer(r'\bKB_MATRIX_LAYER\s*\(', body):
+		(arguments, _) = split_arguments(body, match.end()-1)
+		if len(arguments) != len(positions):
+			raise ValueError( "layer {}: {} keys (expected {})".format(
+			                  len(layers), len(arguments), len(positions) ) )
+		layer = [[None]*columns for _ in range(rows)]
+		for (argument, places) in zip(arguments, positions):
+			for (r, c) in places:
+				layer[r][c] = argument
+		layers.append(layer)
+
+	return layers
+
+# -----------------------------------------------------------------------------
+
+def gen_sparse(layout_name, layers):
+	out = """\
+/* ----------------------------------------------------------------------------
+ * ergoDOX layout : sparse form of "{}"
+ *
+ * Generated by "build-scripts/gen-sparse-layout.py"; don't edit (edit the
+ * layout instead)
+ * ------------------------------------------------------------------------- */
+
+
+""".format(layout_name)
+
+	headers = ''
+	entries = ''
+	start = 0
+	for (l, layer) in enumerate(layers):
+		keys = [key for row in layer for key in row]
+		# the most common action (preferring '0', if it's as common)
+		fill = max( sorted(set(keys), key=lambda k: k != '0'),
+		            key=keys.count )
+
+		defined = []
+		before = []
+		count = 0
+		entries += '\t// layer {}\n'.format(l)
+		for row in layer:
+			row_entries = [key for key in row if key != fill]
+			defined.append( sum( 1 << c for (c, key) in enumerate(row)
+			                     if key != fill ) )
+			before.append(count)
+			count += len(row_entries)
+			if row_entries:
+				entries += '\t' + ', '.join(row_entries) + ',\n'
+
+		headers += (
+			'\t{{  // layer {}\n'.format(l) +
+			'\t\t.fill    = {},\n'.format(fill) +
+			'\t\t.entries = {},\n'.format(start) +
+			'\t\t.defined = {{ {} }},\n'.format(
+				', '.join('0x{:04X}'.format(d) for d in defined) ) +
+			'\t\t.before  = {{ {} }},\n'.format(
+				', '.join(str(b) for b in before) ) +
+			'\t},\n' )
+		start += count
+
+	out += 'const kb_layout_sparse_t PROGMEM _kb_layout_sparse[KB_LAYERS] = {\n'
+	out += headers
+	out += '};\n\n'
+	out += 'const uint16_t PROGMEM _kb_layout_entries[] = {\n'
+	out += entries if start else '\t0,\n'
+	out += '};\n\n'
+
+	return out
+
+# -----------------------------------------------------------------------------
+
+def main():
+	arg_parser = argparse.ArgumentParser(
+			description = "Generate the sparse form of a layout" )
+
+	arg_parser.add_argument(
+			'--matrix-file-path',
+			help = "the path to the matrix file we're using",
+			required = True )
+	arg_parser.add_argument(
+			'--layout-file-path',
+			help = "the path to the layout file we're using",
+			required = True )
+
+	args = arg_parser.parse_args(sys.argv[1:])
+
+	(rows, columns, positions) = parse_matrix_file(args.matrix_file_path)
+	layers = parse_layout_file( args.layout_file_path,
+	                            rows, columns, positions )
+
+	print( gen_sparse( os.path.basename(args.layout_file_path), layers ),
+	       end='' )
+
+# -----------------------------------------------------------------------------
+
+if __name__ == '__main__':
+	main()
+
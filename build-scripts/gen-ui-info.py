@@ -149,9 +149,7 @@ def gen_derived(data):
 	return {
 		'miscellaneous': {
 			'number-of-layers':
-				int( data['layout-matrices']['_kb_layout']['length']/(6*14) ),
-				# because 6*14 is the number of bytes/layer for '_kb_layout'
-				# (which is a uint8_t matrix)
+				len(data['mappings']['matrix-layout']),
 		},
 	}
 
@@ -350,43 +348,47 @@ def gen_mappings(matrix_file_path, layout_file_path):
 		}
 
 	def parse_layout_file(layout_file_path):
-		match = re.findall(  # find each whole '_kb_layout*' matrix definition
-				r'(_kb_layout\w*)[^=]*=((?:[^{}]*\{){3}[^=]*(?:[^{}]*\}){3})',
-				subprocess.getoutput("gcc -E '"+layout_file_path+"'") )
-
-		layout = {}
-		# collect all the values
-		for (name, matrix) in match:
-			layout[name] = [
-					re.findall(  # find all numbers and function pointers
-						r'[x0-9A-F]+|&\w+|NULL',
-						re.sub(  # replace '((void *) 0)' with 'NULL'
-							r'\(\s*\(\s*void\s*\*\s*\)\s*0\s*\)',
-							'NULL',
-							el ) )
-					for el in
-						re.findall(  # find each whole layer
-							r'(?:[^{}]*\{){2}((?:[^}]|\}\s*,)+)(?:[^{}]*\}){2}',
-							matrix ) ]
-
-		# make the numbers into actual numbers
-		layout['_kb_layout'] = \
-				[[eval(el) for el in layer] for layer in layout['_kb_layout']]
-		# remove the preceeding '&' from function pointers
-		for matrix in ('_kb_layout_press', '_kb_layout_release'):
-			layout[matrix] = \
-					[ [re.sub(r'&', '', el) for el in layer]
-					  for layer in layout[matrix] ]
+		source = subprocess.getoutput("gcc -E -P '"+layout_file_path+"'")
+		source = re.sub(  # replace '((void *) 0)' with 'NULL'
+				r'\(\s*\(\s*void\s*\*\s*\)\s*0\s*\)', 'NULL', source )
+
+		# the kinds, in order, as [press, release] (without the '&'s)
+		names = re.findall(
+				r'\w+', re.search(r'enum\s+kinds\s*\{([^}]*)\}', source).group(1) )
+		functions = dict(
+				(name, [re.sub(r'&', '', press), re.sub(r'&', '', release)])
+				for (name, press, release) in re.findall(
+					r'\[\s*(\w+)\s*\]\s*=\s*\{\s*(&?\w+)\s*,\s*(&?\w+)\s*\}',
+					re.search( r'_kb_layout_kinds\s*\[\s*\]\s*=\s*\{(.*?)\};',
+					           source, re.DOTALL ).group(1) ) )
+		kinds = [functions[name] for name in names]
+
+		# each key, as [keycode, press, release]
+		def parse_action(kind, keycode):
+			if not kind:  # '0'
+				return [0] + kinds[0]
+			try:
+				keycode = eval(keycode)
+			except Exception:
+				pass
+			return [keycode] + kinds[names.index(kind)]
+
+		matrix = re.search(
+				r'_kb_layout\s*\[[^=;]*=(.*?)\};', source, re.DOTALL ).group(1)
+		layers = [
+				[ parse_action(kind, keycode)
+				  for (kind, keycode) in re.findall(
+					r'\(\s*\(uint16_t\)\s*\((\w+)\)\s*<<\s*8\s*\|'
+					r'\s*\(uint8_t\)\s*\(([^()]*)\)\s*\)|(?<![\w(])0(?![\w)])',
+					el ) ]
+				for el in
+					re.findall(  # find each whole layer
+						r'(?:[^{}]*\{){2}((?:[^}]|\}\s*,)+)(?:[^{}]*\}){2}',
+						matrix ) ]
 
 		return {
 			"mappings": {
-				"matrix-layout":
-					# group them all properly
-					[ [[c, p, r] for (c, p, r) in zip(code, press, release)]
-					  for (code, press, release) in
-						  zip( layout['_kb_layout'],
-							   layout['_kb_layout_press'],
-							   layout['_kb_layout_release'] ) ]
+				"matrix-layout": layers
 			},
 		}
 
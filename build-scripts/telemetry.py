@@ -0,0 +1,234 @@
+#! /usr/bin/env python3
+# -----------------------------------------------------------------------------
+# Copyright (c) 2026 The ergodox-firmware contributors
+# Released under The MIT License (MIT) (see "license.md")
+# Project located at <https://github.com/benblazak/ergodox-firmware>
+# -----------------------------------------------------------------------------
+
+"""
+Read counters from, and change settings on, a running keyboard
+
+Talks to the raw HID interface (see "src/telemetry.c" for the protocol),
+through hidraw; so Linux only.  You'll need read/write access to the
+'/dev/hidraw*' device (e.g. run as root, or add a udev rule).
+
+Examples:
+	telemetry.py counters
+	telemetry.py watch --interval 0.5
+	telemetry.py clear
+	telemetry.py settings
+	telemetry.py set debounce-time 8
+"""
+
+# -----------------------------------------------------------------------------
+
+import argparse
+import glob
+import os
+import select
+import struct
+import sys
+import time
+
+# -----------------------------------------------------------------------------
+
+VENDOR_ID  = 0x1d50
+PRODUCT_ID = 0x6028
+
+# the start of the raw HID interface's report descriptor: Usage Page (0xFFAB)
+RAWHID_DESCRIPTOR = bytes([0x06, 0xAB, 0xFF])
+RAWHID_SIZE = 64
+
+VERSION = 1
+
+PING           = 0x00
+GET_COUNTERS   = 0x01
+CLEAR_COUNTERS = 0x02
+GET_SETTINGS   = 0x03
+SET_SETTING    = 0x04
+
+SETTINGS = {
+	'debounce-time':  0x00,
+	'debounce-mode':  0x01,
+	'scan-rate':      0x02,
+	'led-brightness': 0x03,
+}
+
+STATUS = {
+	0x00: "ok",
+	0x01: "unknown command",
+	0x02: "unknown setting",
+	0x03: "value out of range",
+}
+
+# (name, struct format), in the order they're sent
+COUNTERS = [
+	('subticks-per-us',         'B'),
+	('scan-rate',               'H'),
+	('scan-duration',           'H'),
+	('scan-duration-max',       'H'),
+	('scan-ticks-missed',       'H'),
+	('idle',                    'B'),
+	('idle-wake-duration',      'H'),
+	('idle-wake-duration-max',  'H'),
+	('sof-sync-error',          'h'),
+	('twi-timeout',             'H'),
+	('twi-recovered',           'H'),
+	('twi-sla-nack',            'H'),
+	('twi-data-nack',           'H'),
+	('twi-arbitration',         'H'),
+	('twi-other',               'H'),
+	('usb-reports-sent',        'H'),
+	('usb-report-rate',         'H'),
+	('usb-report-overflows',    'H'),
+	('usb-report-queue-depth',  'B'),
+]
+
+# counters that are durations, in timer subticks
+DURATIONS = [ 'scan-duration', 'scan-duration-max', 'idle-wake-duration',
+              'idle-wake-duration-max', 'sof-sync-error' ]
+
+# -----------------------------------------------------------------------------
+
+def find_device():
+	"""Return the path of the keyboard's raw HID hidraw device"""
+	hid_id = '0003:{:08X}:{:08X}'.format(VENDOR_ID, PRODUCT_ID)
+	for path in sorted(glob.glob('/sys/class/hidraw/hidraw*')):
+		try:
+			with open(os.path.join(path, 'device', 'uevent')) as f:
+				if ('HID_ID=' + hid_id) not in f.read().upper():
+					continue
+			with open(os.path.join(path, 'device', 'report_descriptor'),
+					'rb') as f:
+				if not f.read().startswith(RAWHID_DESCRIPTOR):
+					continue
+		except OSError:
+			continue
+		return os.path.join('/dev', os.path.basename(path))
+	return None
+
+class Keyboard():
+	def __init__(self, path, timeout=1.0):
+		self.fd = os.open(path, os.O_RDWR)
+		self.timeout = timeout
+
+	def close(self):
+		os.close(self.fd)
+
+	def request(self, command, *args):
+		"""Send a request; return the result bytes (after checking status)"""
+		data = bytes([command] + list(args))
+		# (the leading 0 is the report ID, which we don't use)
+		os.write(self.fd, b'\x00' + data.ljust(RAWHID_SIZE, b'\x00'))
+
+		end = time.time() + self.timeout
+		while True:
+			remaining = end - time.time()
+			if remaining <= 0:
+				break
+			if not select.select([self.fd], [], [], remaining)[0]:
+				break
+			response = os.read(self.fd, RAWHID_SIZE)
+			if response[0] != command:
+				continue  # a stale response, from an earlier request
+			if response[1] != 0:
+				raise RuntimeError( STATUS.get( response[1],
+				                                "status " + str(response[1]) ) )
+			return response[2:]
+		raise RuntimeError("no response")
+
+	def ping(self):
+		return self.request(PING)[0]
+
+	def counters(self):
+		fmt = '<' + ''.join(f for _, f in COUNTERS)
+		values = struct.unpack_from(fmt, self.request(GET_COUNTERS))
+		return dict(zip((n for n, _ in COUNTERS), values))
+
+	def clear(self):
+		self.request(CLEAR_COUNTERS)
+
+	def settings(self):
+		values = struct.unpack_from('<BBHB', self.request(GET_SETTINGS))
+		return dict(zip(SETTINGS.keys(), values))
+
+	def set(self, name, value):
+		self.request( SET_SETTING, SETTINGS[name],
+		              value & 0xFF, (value >> 8) & 0xFF )
+
+# -----------------------------------------------------------------------------
+
+def print_counters(counters):
+	per_us = counters['subticks-per-us'] or 1
+	for name, value in counters.items():
+		if name == 'subticks-per-us':
+			continue
+		if name in DURATIONS:
+			print('{:24} {:8.1f} us'.format(name, value / per_us))
+		else:
+			print('{:24} {:8}'.format(name, value))
+
+def main():
+	arg_parser = argparse.ArgumentParser(
+			description = "Talk to a running keyboard, over raw HID" )
+	arg_parser.add_argument(
+			'--device',
+			help = "the hidraw device to use (found automatically if not "
+			       "given)" )
+	sub = arg_parser.add_subparsers(dest='command')
+	sub.add_parser('counters', help="print the counters")
+	watch = sub.add_parser('watch', help="print the counters, repeatedly")
+	watch.add_argument( '--interval', type=float, default=1.0,
+	                    help="in seconds" )
+	sub.add_parser('clear', help="clear the maxima and error counts")
+	sub.add_parser('settings', help="print the current settings")
+	set_ = sub.add_parser('set', help="change a setting (until reset)")
+	set_.add_argument('name', choices=SETTINGS.keys())
+	set_.add_argument('value', type=int)
+
+	args = arg_parser.parse_args(sys.argv[1:])
+	if not args.command:
+		arg_parser.print_help()
+		return 1
+
+	path = args.device or find_device()
+	if not path:
+		print("keyboard not found", file=sys.stderr)
+		return 1
+
+	keyboard = Keyboard(path)
+	try:
+		version = keyboard.ping()
+		if version != VERSION:
+			print( "warning: protocol version {} (expected {})"
+			       .format(version, VERSION), file=sys.stderr )
+
+		if args.command == 'counters':
+			print_counters(keyboard.counters())
+		elif args.command == 'watch':
+			while True:
+				print_counters(keyboard.counters())
+				print()
+				time.sleep(args.interval)
+		elif args.command == 'clear':
+			keyboard.clear()
+		elif args.command == 'settings':
+			for name, value in keyboard.settings().items():
+				print('{:24} {:8}'.format(name, value))
+		elif args.command == 'set':
+			keyboard.set(args.name, args.value)
+	except KeyboardInterrupt:
+		pass
+	except RuntimeError as e:
+		print("error: " + str(e), file=sys.stderr)
+		return 1
+	finally:
+		keyboard.close()
+
+	return 0
+
+# -----------------------------------------------------------------------------
+
+if __name__ == '__main__':
+	sys.exit(main())
+
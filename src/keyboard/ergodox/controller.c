@@ -31,13 +31,119 @@ uint8_t kb_init(void) {
 /* returns
  * - success: 0
  * - error: number of the function that failed
+ *
+ * notes:
+ * - the update functions only set the bits of the keys that are pressed, so
+ *   the matrix is cleared here first
+ * - the two halves are scanned in parallel: the MCP23018 scan is queued
+ *   first, and runs over I2C (from the TWI interrupt) while the Teensy half
+ *   is scanned on local GPIO.  the total is then about the longer of the
+ *   two, instead of their sum.
+ *     - estimates, at 16MHz with the default 400kHz I2C clock (1 bit
+ *       time = 40 cycles), against the scan this replaced:
+ *         - before: `mcp23018_init()` on every pass (3 transactions of 4
+ *           bytes ~= 115 bit times), then per strobe one write transaction
+ *           (3 bytes) and one read transaction (2 bytes, a repeated
+ *           start, 2 more bytes) ~= 68 bit times, then the release (~30)
+ *           ~= 620 bit times ~= 24800 cycles (~1.55ms), all of it busy
+ *           waiting; then the Teensy half (7 strobes * (2 * 16 cycles
+ *           settle + ~40 cycles of reads)) ~= 500 cycles, after it.
+ *           total ~= 25300 cycles (~1.6ms).
+ *         - now: the MCP23018 half is 7 strobes * (5 bytes * 9 bits + 2
+ *           repeated starts) + the release (3 bytes + stop) ~= 375 bit
+ *           times ~= 15000 cycles (~940us); the Teensy half (7 strobes *
+ *           (16 cycles settle + ~50 cycles of reads and shifts) ~= 500
+ *           cycles) runs during it.  total ~= 15000 cycles, with the CPU
+ *           free for all but the ~50 short TWI interrupts.
+ *         - so most of the gain is in the left hand (no init every pass,
+ *           one chained transaction); running the halves in parallel only
+ *           hides the ~500 cycles of the Teensy half.
+ *     - these are paper figures, not measurements.  the real scans also
+ *       spend time between bytes (polling before; interrupt latency now),
+ *       so both are somewhat longer.  `main_scan_duration` (in "main.c")
+ *       measures the real thing; read it (and the ticks missed) over
+ *       telemetry.
+ *     - so the I2C half alone takes ~94% of a 1ms tick: this is why
+ *       `SCAN_RATE` (in "makefile-options") defaults to 500Hz
+ * - every I2C wait is bounded, so even with the left hand misbehaving (a
+ *   stuck bus, or a flaky cable) the MCP23018 half can take at most:
+ *     - scan: ~50 interrupts * `TWI_TIMEOUT_US` (90us; up to ~120us, by
+ *       the spin count), + ~100us for the bus recovery ~= 6ms.  in
+ *       practice, a hang is caught at the first stuck event, ~200us after
+ *       the last good one.
+ *     - probe (while disconnected): ~15 synchronous operations * ~120us,
+ *       + the recovery ~= 2ms, at most once per backoff period
  */
-uint8_t kb_update_matrix(bool matrix[KB_ROWS][KB_COLUMNS]) {
-	if (teensy_update_matrix(matrix))
+uint8_t kb_update_matrix(uint16_t matrix[KB_ROWS]) {
+	bool teensy_err, mcp23018_err;
+
+	for (uint8_t row=0; row<KB_ROWS; row++)
+		matrix[row] = 0;
+
+	mcp23018_err  = mcp23018_update_matrix_start();
+	teensy_err    = teensy_update_matrix(matrix);
+	mcp23018_err |= mcp23018_update_matrix_finish(matrix);
+
+	if (teensy_err)
 		return 1;
-	if (mcp23018_update_matrix(matrix))
+	if (mcp23018_err)
 		return 2;
 
 	return 0;  // success
 }
+/*
+ * idle mode
+ * - for when no key has been down for a while: instead of scanning, drive
+ *   every strobe line low on both halves, and poll the inputs once a tick
+ *   (see the `*_idle_*()` functions for details)
+ * - `kb_idle_poll()` returns whether any key is down, checking the Teensy
+ *   half first, since it's free; on true, the caller should
+ *   `kb_idle_exit()` and go back to scanning
+ */
+void kb_idle_enter(void) {
+	teensy_idle_enter();
+	mcp23018_idle_enter();
+}
+
+bool kb_idle_poll(void) {
+	return teensy_idle_poll() || mcp23018_idle_poll();
+}
+
+void kb_idle_exit(void) {
+	teensy_idle_exit();
+	mcp23018_idle_exit();
+}
+
+/*
+ * suspend mode
+ * - for while the USB bus is suspended: idle mode, with the LEDs off, and
+ *   with the left half polled only every `SUSPEND_MCP23018_POLLS` calls to
+ *   `kb_suspend_poll()`, to cut down on TWI traffic (and time awake)
+ * - `kb_suspend_poll()` is meant to be called after every wake from a long
+ *   sleep (see `timer_sleep_long()`); on true, the caller should ask the
+ *   host to wake up
+ */
+#define  SUSPEND_MCP23018_POLLS  4
+
+static uint8_t _suspend_polls;
+
+void kb_suspend_enter(void) {
+	teensy_suspend_enter();
+	mcp23018_idle_enter();
+	_suspend_polls = 0;
+}
+
+bool kb_suspend_poll(void) {
+	if (teensy_idle_poll())
+		return true;
+	if (++_suspend_polls < SUSPEND_MCP23018_POLLS)
+		return false;
+	_suspend_polls = 0;
+	return mcp23018_idle_poll();
+}
+
+void kb_suspend_exit(void) {
+	teensy_suspend_exit();
+	mcp23018_idle_exit();
+}
 
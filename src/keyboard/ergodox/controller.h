@@ -21,7 +21,15 @@
 	// --------------------------------------------------------------------
 
 	uint8_t kb_init(void);
-	uint8_t kb_update_matrix(bool matrix[KB_ROWS][KB_COLUMNS]);
+	uint8_t kb_update_matrix(uint16_t matrix[KB_ROWS]);
+
+	void kb_idle_enter (void);
+	bool kb_idle_poll  (void);
+	void kb_idle_exit  (void);
+
+	void kb_suspend_enter (void);
+	bool kb_suspend_poll  (void);
+	void kb_suspend_exit  (void);
 
 #endif
 
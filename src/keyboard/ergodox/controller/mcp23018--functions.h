@@ -21,7 +21,13 @@
 	// --------------------------------------------------------------------
 
 	uint8_t mcp23018_init(void);
-	uint8_t mcp23018_update_matrix( bool matrix[KB_ROWS][KB_COLUMNS] );
+	uint8_t mcp23018_update_matrix( uint16_t matrix[KB_ROWS] );
+	uint8_t mcp23018_update_matrix_start  (void);
+	uint8_t mcp23018_update_matrix_finish ( uint16_t matrix[KB_ROWS] );
+
+	void    mcp23018_idle_enter (void);
+	bool    mcp23018_idle_poll  (void);
+	void    mcp23018_idle_exit  (void);
 
 #endif
 
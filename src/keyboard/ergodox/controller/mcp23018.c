@@ -8,9 +8,10 @@
 
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <util/twi.h>
-#include "../../../lib/twi.h"  // `TWI_FREQ` defined in "teensy-2-0.c"
+#include "../../../lib/twi.h"
 #include "../options.h"
 #include "../matrix.h"
 #include "./mcp23018--functions.h"
@@ -28,6 +29,7 @@
 // register addresses (see "mcp23018.md")
 #define IODIRA 0x00  // i/o direction register
 #define IODIRB 0x01
+#define IOCON  0x0A  // i/o control register (also at 0x0B)
 #define GPPUA  0x0C  // GPIO pull-up resistor register
 #define GPPUB  0x0D
 #define GPIOA  0x12  // general purpose i/o port register (write modifies OLAT)
@@ -35,10 +37,53 @@
 #define OLATA  0x14  // output latch register
 #define OLATB  0x15
 
+// IOCON value
+// - BANK = 0, SEQOP = 1: "byte mode"; the address pointer toggles between
+//   the A and B registers of a pair, instead of incrementing
+#define IOCON_VALUE 0b00100000
+
 // TWI aliases
 #define TWI_ADDR_WRITE ( (MCP23018_TWI_ADDRESS<<1) | TW_WRITE )
 #define TWI_ADDR_READ  ( (MCP23018_TWI_ADDRESS<<1) | TW_READ  )
 
+// the port we drive (in byte mode, writing it leaves the address pointer on
+// the port we read)
+#if MCP23018__DRIVE_ROWS
+	#define GPIO_DRIVE GPIOB
+	#define GPIO_READ  GPIOA
+	#define READ_MASK  0b01111111  // columns 0..6
+#elif MCP23018__DRIVE_COLUMNS
+	#define GPIO_DRIVE GPIOA
+	#define GPIO_READ  GPIOB
+	#define READ_MASK  0b00111111  // rows 5..0
+#endif
+
+// re-probe backoff, for when the left hand isn't connected
+// - in scans; doubles after each failed probe, from MIN up to MAX
+#define BACKOFF_MS_TO_SCANS(ms)  \
+	( ((uint32_t)(ms) * MAKEFILE_SCAN_RATE + 999) / 1000 )
+#define BACKOFF_MIN  BACKOFF_MS_TO_SCANS(8)
+#define BACKOFF_MAX  BACKOFF_MS_TO_SCANS(1024)
+
+// ----------------------------------------------------------------------------
+
+static bool     _connected;  // whether the last init (and scan) succeeded
+static uint16_t _backoff;    // scans to wait after the next failed probe
+static uint16_t _wait;       // scans left until the next probe
+
+// the queued scan (see `mcp23018_update_matrix_start()`)
+// - one transfer per strobe (write the drive port, read the other), and one
+//   to set everything back to hi-Z
+#if MCP23018__DRIVE_ROWS
+	#define STROBES 6
+#elif MCP23018__DRIVE_COLUMNS
+	#define STROBES 7
+#endif
+static uint8_t         _strobe[STROBES+1][2];  // register address, value
+static uint8_t         _data[STROBES];         // what was read back
+static struct twi_xfer _xfer[STROBES+1];
+static bool            _queued;  // whether `_xfer` was queued this scan
+
 // ----------------------------------------------------------------------------
 
 /* returns:
@@ -46,19 +91,25 @@
  * - failure: twi status code
  *
  * notes:
- * - `twi_stop()` must be called *exactly once* for each twi block, the way
- *   things are currently set up.  this may change in the future.
+ * - must be called with a start (or repeated start) already sent; leaves
+ *   the bus held (no stop), so the caller can go on with a repeated start
+ * - all the configuration is written as one chain of repeated starts
  */
-uint8_t mcp23018_init(void) {
+static uint8_t _init_chain(void) {
 	uint8_t ret;
 
+	// set byte mode (see `IOCON_VALUE`)
+	ret = twi_send(TWI_ADDR_WRITE);
+	if (ret) return ret;  // make sure we got an ACK
+	twi_send(IOCON);
+	twi_send(IOCON_VALUE);
+
 	// set pin direction
 	// - unused  : input  : 1
 	// - input   : input  : 1
 	// - driving : output : 0
 	twi_start();
-	ret = twi_send(TWI_ADDR_WRITE);
-	if (ret) goto out;  // make sure we got an ACK
+	twi_send(TWI_ADDR_WRITE);
 	twi_send(IODIRA);
 	#if MCP23018__DRIVE_ROWS
 		twi_send(0b11111111);  // IODIRA
@@ -67,15 +118,13 @@ uint8_t mcp23018_init(void) {
 		twi_send(0b10000000);  // IODIRA
 		twi_send(0b11111111);  // IODIRB
 	#endif
-	twi_stop();
 
 	// set pull-up
 	// - unused  : on  : 1
 	// - input   : on  : 1
 	// - driving : off : 0
 	twi_start();
-	ret = twi_send(TWI_ADDR_WRITE);
-	if (ret) goto out;  // make sure we got an ACK
+	twi_send(TWI_ADDR_WRITE);
 	twi_send(GPPUA);
 	#if MCP23018__DRIVE_ROWS
 		twi_send(0b11111111);  // GPPUA
@@ -84,21 +133,94 @@ uint8_t mcp23018_init(void) {
 		twi_send(0b10000000);  // GPPUA
 		twi_send(0b11111111);  // GPPUB
 	#endif
-	twi_stop();
 
 	// set logical value (doesn't matter on inputs)
 	// - unused  : hi-Z : 1
 	// - input   : hi-Z : 1
 	// - driving : hi-Z : 1
 	twi_start();
-	ret = twi_send(TWI_ADDR_WRITE);
-	if (ret) goto out;  // make sure we got an ACK
+	twi_send(TWI_ADDR_WRITE);
 	twi_send(OLATA);
 	twi_send(0b11111111);  //OLATA
 	twi_send(0b11111111);  //OLATB
 
-out:
+	return 0;  // success
+}
+
+/* returns:
+ * - success: 0
+ * - failure: twi status code
+ *
+ * notes:
+ * - `twi_stop()` must be called *exactly once* for each twi block, the way
+ *   things are currently set up.  this may change in the future.
+ */
+static uint8_t _probe(void) {
+	uint8_t ret;
+
+	twi_start();
+	ret = _init_chain();
 	twi_stop();
+
+	return ret;
+}
+
+/* returns:
+ * - connected: 0
+ * - not connected: twi status code (or `TW_NO_INFO`, while waiting to
+ *   re-probe)
+ *
+ * notes:
+ * - while disconnected, probes (with a full init) on an exponential backoff
+ */
+static uint8_t _connect(void) {
+	uint8_t ret;
+
+	if (_connected)
+		return 0;
+
+	if (_wait) {
+		_wait--;
+		return TW_NO_INFO;
+	}
+
+	ret = _probe();
+	if (ret) {
+		_wait    = _backoff;
+		_backoff = (_backoff < BACKOFF_MAX/2) ? _backoff*2 : BACKOFF_MAX;
+		return ret;
+	}
+
+	_connected = true;
+	_backoff   = BACKOFF_MIN;
+	return 0;
+}
+
+// after an error: probe again right away (in case it was just a glitch)
+static void _disconnect(void) {
+	_connected = false;
+	_backoff   = BACKOFF_MIN;
+	_wait      = 0;
+}
+
+/* returns:
+ * - success: 0
+ * - failure: twi status code
+ *
+ * notes:
+ * - writes `value` to the port we drive, with a single short transfer
+ */
+static uint8_t _drive(uint8_t value) {
+	uint8_t data[] = { GPIO_DRIVE, value };
+	struct twi_xfer xfer = {
+		.address   = MCP23018_TWI_ADDRESS,
+		.write     = data,
+		.write_len = 2,
+	};
+
+	uint8_t ret = twi_transfer(&xfer);
+	if (ret)
+		_disconnect();
 	return ret;
 }
 
@@ -106,101 +228,189 @@ out:
  * - success: 0
  * - failure: twi status code
  */
+uint8_t mcp23018_init(void) {
+	uint8_t ret = _probe();
+
+	_connected = !ret;
+	_backoff   = BACKOFF_MIN;
+	_wait      = 0;
+
+	// set up the scan transfers
+	// - active row (or column) low : 0
+	// - all others hi-Z            : 1
+	// - the last transfer sets everything back to hi-Z
+	for (uint8_t i=0; i<=STROBES; i++) {
+		_strobe[i][0] = GPIO_DRIVE;
+		#if MCP23018__DRIVE_ROWS
+			_strobe[i][1] = 0xFF & ~(1<<(5-i));
+		#elif MCP23018__DRIVE_COLUMNS
+			_strobe[i][1] = 0xFF & ~(1<<i);
+		#endif
+
+		_xfer[i].address   = MCP23018_TWI_ADDRESS;
+		_xfer[i].write     = _strobe[i];
+		_xfer[i].write_len = 2;
+		_xfer[i].read      = &_data[i];
+		_xfer[i].read_len  = 1;
+		_xfer[i].flags     = TWI_NO_STOP;
+		_xfer[i].callback  = NULL;
+	}
+	_strobe[STROBES][1]      = 0xFF;
+	_xfer[STROBES].read_len  = 0;
+	_xfer[STROBES].flags     = 0;
+
+	return ret;
+}
+
+/* returns:
+ * - success: 0
+ * - failure: twi status code (or `TW_NO_INFO`, while waiting to re-probe)
+ *
+ * notes:
+ * - queues the scan of our half, to run (from `TWI_vect`) while the caller
+ *   does something else -- the Teensy half of the scan, for one.  the
+ *   results go into the matrix when `mcp23018_update_matrix_finish()` is
+ *   called.
+ * - the full init is only done on connect (synchronously; the rare case).
+ *   while connected, the ACK of each strobe write is checked instead; a NACK
+ *   means the left hand was unplugged.  while disconnected, we probe on an
+ *   exponential backoff, so an unplugged half costs (almost) nothing.
+ * - a half that's unplugged and plugged back in can't get through a whole
+ *   scan period without a NACK, so its (reset) registers are always
+ *   re-initialized before being scanned
+ * - the queued transfers chain into each other with repeated starts, so the
+ *   scan is a single bus transaction, with one stop at the end
+ * - in byte mode, writing the drive port moves the address pointer to the
+ *   other port of the pair, so each strobe is
+ *       SR OP W ADDR Din SR OP R Dout
+ *   (5 bytes) with the read needing no address of its own
+ */
+uint8_t mcp23018_update_matrix_start(void) {
+	uint8_t ret;
+
+	_queued = false;
+
+	ret = _connect();
+	if (ret)
+		return ret;
+
+	for (uint8_t i=0; i<=STROBES; i++)
+		twi_queue(&_xfer[i]);
+	_queued = true;
+
+	return 0;  // success
+}
+
+/* returns:
+ * - success: 0
+ * - failure: twi status code
+ *
+ * notes:
+ * - waits for the transfers queued by `mcp23018_update_matrix_start()`
+ *   (if any) to complete
+ * - only sets the bits (columns 0..6) of keys that are pressed; the matrix
+ *   must be cleared beforehand (so on failure, our half reads as released)
+ */
 #if KB_ROWS != 6 || KB_COLUMNS != 14
 	#error "Expecting different keyboard dimensions"
 #endif
-uint8_t mcp23018_update_matrix(bool matrix[KB_ROWS][KB_COLUMNS]) {
-	uint8_t ret, data;
+uint8_t mcp23018_update_matrix_finish(uint16_t matrix[KB_ROWS]) {
+	uint8_t ret;
 
-	// initialize things, just to make sure
-	// - it's not appreciably faster to skip this, and it takes care of the
-	//   case when the i/o expander isn't plugged in during the first
-	//   init()
-	ret = mcp23018_init();
+	if (!_queued)
+		return 0;
+	_queued = false;
 
-	// if there was an error
-	if (ret) {
-		// clear our part of the matrix
-		for (uint8_t row=0; row<=5; row++)
-			for (uint8_t col=0; col<=6; col++)
-				matrix[row][col] = 0;
+	twi_wait(&_xfer[STROBES]);  // bounded; see "lib/twi"
 
-		return ret;
+	for (uint8_t i=0; i<=STROBES; i++) {
+		ret = _xfer[i].status;
+		if (ret) {
+			_disconnect();
+			return ret;
+		}
 	}
 
-
 	// --------------------------------------------------------------------
 	// update our part of the matrix
 
 	#if MCP23018__DRIVE_ROWS
-		for (uint8_t row=0; row<=5; row++) {
-			// set active row low  : 0
-			// set other rows hi-Z : 1
-			twi_start();
-			twi_send(TWI_ADDR_WRITE);
-			twi_send(GPIOB);
-			twi_send( 0xFF & ~(1<<(5-row)) );
-			twi_stop();
-
-			// read column data
-			twi_start();
-			twi_send(TWI_ADDR_WRITE);
-			twi_send(GPIOA);
-			twi_start();
-			twi_send(TWI_ADDR_READ);
-			twi_read(&data);
-			twi_stop();
-
-			// update matrix
-			for (uint8_t col=0; col<=6; col++) {
-				matrix[row][col] = !( data & (1<<col) );
-			}
-		}
-
-		// set all rows hi-Z : 1
-		twi_start();
-		twi_send(TWI_ADDR_WRITE);
-		twi_send(GPIOB);
-		twi_send(0xFF);
-		twi_stop();
+		for (uint8_t row=0; row<=5; row++)
+			matrix[row] |= ~_data[row] & 0b01111111;
 
 	#elif MCP23018__DRIVE_COLUMNS
 		for (uint8_t col=0; col<=6; col++) {
-			// set active column low  : 0
-			// set other columns hi-Z : 1
-			twi_start();
-			twi_send(TWI_ADDR_WRITE);
-			twi_send(GPIOA);
-			twi_send( 0xFF & ~(1<<col) );
-			twi_stop();
-
-			// read row data
-			twi_start();
-			twi_send(TWI_ADDR_WRITE);
-			twi_send(GPIOB);
-			twi_start();
-			twi_send(TWI_ADDR_READ);
-			twi_read(&data);
-			twi_stop();
-
-			// update matrix
 			for (uint8_t row=0; row<=5; row++) {
-				matrix[row][col] = !( data & (1<<(5-row)) );
+				if (!( _data[col] & (1<<(5-row)) ))
+					matrix[row] |= (1<<col);
 			}
 		}
 
-		// set all columns hi-Z : 1
-		twi_start();
-		twi_send(TWI_ADDR_WRITE);
-		twi_send(GPIOA);
-		twi_send(0xFF);
-		twi_stop();
-
 	#endif
 
 	// /update our part of the matrix
 	// --------------------------------------------------------------------
 
-	return ret;  // success
+	return 0;  // success
+}
+
+/* returns:
+ * - success: 0
+ * - failure: twi status code (or `TW_NO_INFO`, while waiting to re-probe)
+ *
+ * notes:
+ * - the same as `..._start()` then `..._finish()`, with nothing in between
+ */
+uint8_t mcp23018_update_matrix(uint16_t matrix[KB_ROWS]) {
+	uint8_t ret = mcp23018_update_matrix_start();
+	if (ret)
+		return ret;
+	return mcp23018_update_matrix_finish(matrix);
+}
+
+/* idle mode
+ * - `mcp23018_idle_enter()` drives every row (or column) low at once.  after
+ *   that, any key pressed pulls its input low, so one read of the other
+ *   port (`mcp23018_idle_poll()`: 4 bytes, instead of the 38 of a scan)
+ *   tells us whether anything on our half is down.
+ * - the INTA/INTB pins aren't connected (see "mcp23018.md"), so we can't
+ *   use the chip's interrupt-on-change to wake up; polling once a tick is
+ *   the next best thing
+ * - a half that connects while idle is initialized and driven on the next
+ *   probe
+ */
+void mcp23018_idle_enter(void) {
+	if (_connected)
+		_drive(0x00);
+}
+
+bool mcp23018_idle_poll(void) {
+	bool was_connected = _connected;
+	uint8_t reg = GPIO_READ;
+	uint8_t data;
+	struct twi_xfer xfer = {
+		.address   = MCP23018_TWI_ADDRESS,
+		.write     = &reg,
+		.write_len = 1,
+		.read      = &data,
+		.read_len  = 1,
+	};
+
+	if (_connect())
+		return false;
+	if (!was_connected && _drive(0x00))
+		return false;
+
+	if (twi_transfer(&xfer)) {
+		_disconnect();
+		return false;
+	}
+
+	return ~data & READ_MASK;
+}
+
+void mcp23018_idle_exit(void) {
+	if (_connected)
+		_drive(0xFF);
 }
 
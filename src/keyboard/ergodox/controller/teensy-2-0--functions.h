@@ -17,7 +17,14 @@
 	// --------------------------------------------------------------------
 
 	uint8_t teensy_init(void);
-	uint8_t teensy_update_matrix( bool matrix[KB_ROWS][KB_COLUMNS] );
+	uint8_t teensy_update_matrix( uint16_t matrix[KB_ROWS] );
+
+	void    teensy_idle_enter (void);
+	bool    teensy_idle_poll  (void);
+	void    teensy_idle_exit  (void);
+
+	void    teensy_suspend_enter (void);
+	void    teensy_suspend_exit  (void);
 
 #endif
 
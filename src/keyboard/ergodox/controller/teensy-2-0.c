@@ -7,9 +7,6 @@
  * ------------------------------------------------------------------------- */
 
 
-// for "lib/twi.h"
-#define TWI_FREQ 400000
-
 #include <stdbool.h>
 #include <stdint.h>
 #include <avr/io.h>
@@ -76,20 +73,30 @@
 #define  COLUMN_C  D, 3
 #define  COLUMN_D  C, 6
 
+// --- port snapshots
+// - each `*_ports_read()` must read every port that one of its pins is on,
+//   into a variable named `pin_<letter>`.  if you move `ROW` or `COLUMN`
+//   pins to a different port, update these too.
+#define  row_ports_read()	\
+	uint8_t pin_F = PINF
+#define  column_ports_read()	\
+	uint8_t pin_B = PINB, pin_C = PINC, pin_D = PIND
+
 // --- helpers
 #define  SET    |=
 #define  CLEAR  &=~
 
+// time to allow pins to stabilize after a strobe, in us
+#define  SETTLE_TIME  1
+
 #define  _teensypin_write(register, operation, pin_letter, pin_number)	\
-	do {								\
-		((register##pin_letter) operation (1<<(pin_number)));	\
-		_delay_us(1);  /* allow pins time to stabilize */	\
-	} while(0)
+	((register##pin_letter) operation (1<<(pin_number)))
 #define  teensypin_write(register, operation, pin)	\
 	_teensypin_write(register, operation, pin)
 
+// read a pin from a port snapshot (see above)
 #define  _teensypin_read(pin_letter, pin_number)	\
-	((PIN##pin_letter) & (1<<(pin_number)))
+	((pin_##pin_letter) & (1<<(pin_number)))
 #define  teensypin_read(pin)	\
 	_teensypin_read(pin)
 
@@ -126,18 +133,35 @@
 
 /*
  * update macros
+ * - these only set bits (for keys that are pressed); the matrix is expected
+ *   to have been cleared beforehand
+ * - each strobe waits `SETTLE_TIME` once, then takes a single snapshot of
+ *   the input ports, and extracts every bit from that.  releasing a line
+ *   and driving the next one happen back to back, so the one delay covers
+ *   both edges.
  */
+#define  _matrix_bit(pressed, column)	\
+	( (uint16_t)(pressed) << (column) )
+
 #define  update_rows_for_column(matrix, column)				\
 	do {								\
 		/* set column low (set as output) */			\
 		teensypin_write(DDR, SET, COLUMN_##column);		\
+		_delay_us(SETTLE_TIME);					\
 		/* read rows 0..5 and update matrix */			\
-		matrix[0x0][0x##column] = ! teensypin_read(ROW_0);	\
-		matrix[0x1][0x##column] = ! teensypin_read(ROW_1);	\
-		matrix[0x2][0x##column] = ! teensypin_read(ROW_2);	\
-		matrix[0x3][0x##column] = ! teensypin_read(ROW_3);	\
-		matrix[0x4][0x##column] = ! teensypin_read(ROW_4);	\
-		matrix[0x5][0x##column] = ! teensypin_read(ROW_5);	\
+		row_ports_read();					\
+		matrix[0x0] |= _matrix_bit( ! teensypin_read(ROW_0),	\
+					    0x##column );		\
+		matrix[0x1] |= _matrix_bit( ! teensypin_read(ROW_1),	\
+					    0x##column );		\
+		matrix[0x2] |= _matrix_bit( ! teensypin_read(ROW_2),	\
+					    0x##column );		\
+		matrix[0x3] |= _matrix_bit( ! teensypin_read(ROW_3),	\
+					    0x##column );		\
+		matrix[0x4] |= _matrix_bit( ! teensypin_read(ROW_4),	\
+					    0x##column );		\
+		matrix[0x5] |= _matrix_bit( ! teensypin_read(ROW_5),	\
+					    0x##column );		\
 		/* set column hi-Z (set as input) */			\
 		teensypin_write(DDR, CLEAR, COLUMN_##column);		\
 	} while(0)
@@ -146,14 +170,17 @@
 	do {								\
 		/* set row low (set as output) */			\
 		teensypin_write(DDR, SET, ROW_##row);			\
+		_delay_us(SETTLE_TIME);					\
 		/* read columns 7..D and update matrix */		\
-		matrix[0x##row][0x7] = ! teensypin_read(COLUMN_7);	\
-		matrix[0x##row][0x8] = ! teensypin_read(COLUMN_8);	\
-		matrix[0x##row][0x9] = ! teensypin_read(COLUMN_9);	\
-		matrix[0x##row][0xA] = ! teensypin_read(COLUMN_A);	\
-		matrix[0x##row][0xB] = ! teensypin_read(COLUMN_B);	\
-		matrix[0x##row][0xC] = ! teensypin_read(COLUMN_C);	\
-		matrix[0x##row][0xD] = ! teensypin_read(COLUMN_D);	\
+		column_ports_read();					\
+		matrix[0x##row] |=					\
+			_matrix_bit( ! teensypin_read(COLUMN_7), 0x7 )	\
+		      | _matrix_bit( ! teensypin_read(COLUMN_8), 0x8 )	\
+		      | _matrix_bit( ! teensypin_read(COLUMN_9), 0x9 )	\
+		      | _matrix_bit( ! teensypin_read(COLUMN_A), 0xA )	\
+		      | _matrix_bit( ! teensypin_read(COLUMN_B), 0xB )	\
+		      | _matrix_bit( ! teensypin_read(COLUMN_C), 0xC )	\
+		      | _matrix_bit( ! teensypin_read(COLUMN_D), 0xD );	\
 		/* set row hi-Z (set as input) */			\
 		teensypin_write(DDR, CLEAR, ROW_##row);			\
 	} while(0)
@@ -207,12 +234,16 @@ uint8_t teensy_init(void) {
 
 /* returns
  * - success: 0
+ *
+ * notes:
+ * - only sets the bits (columns 7..D) of keys that are pressed; the matrix
+ *   must be cleared beforehand
  */
 #if KB_ROWS != 6 || KB_COLUMNS != 14
 	#error "Expecting different keyboard dimensions"
 #endif
 
-uint8_t teensy_update_matrix(bool matrix[KB_ROWS][KB_COLUMNS]) {
+uint8_t teensy_update_matrix(uint16_t matrix[KB_ROWS]) {
 	#if TEENSY__DRIVE_ROWS
 		update_columns_for_row(matrix, 0);
 		update_columns_for_row(matrix, 1);
@@ -232,3 +263,67 @@ uint8_t teensy_update_matrix(bool matrix[KB_ROWS][KB_COLUMNS]) {
 
 	return 0;  // success
 }
+
+/* idle mode
+ * - `teensy_idle_enter()` drives every column (or row) low at once.  after
+ *   that, a single read of the input port(s) (`teensy_idle_poll()`) tells
+ *   us whether any key on our half is down.
+ * - port F (the rows) has no pin change interrupts, and the column pins
+ *   that could be external interrupts (D2, D3) are the ones we'd be
+ *   driving, so we can't sleep waiting for an edge.  the CPU sleeps between
+ *   timer ticks anyway, so polling once a tick costs almost nothing.
+ * - the lines are driven long before the first poll (on the next tick), so
+ *   no settle time is needed
+ */
+void teensy_idle_enter(void) {
+	#if TEENSY__DRIVE_ROWS
+		teensypin_write_all_row(DDR, SET);  // set low (set as output)
+	#elif TEENSY__DRIVE_COLUMNS
+		teensypin_write_all_column(DDR, SET);  // set low (set as output)
+	#endif
+}
+
+bool teensy_idle_poll(void) {
+	#if TEENSY__DRIVE_ROWS
+		column_ports_read();
+		return !( teensypin_read(COLUMN_7) && teensypin_read(COLUMN_8)
+		       && teensypin_read(COLUMN_9) && teensypin_read(COLUMN_A)
+		       && teensypin_read(COLUMN_B) && teensypin_read(COLUMN_C)
+		       && teensypin_read(COLUMN_D) );
+	#elif TEENSY__DRIVE_COLUMNS
+		row_ports_read();
+		return !( teensypin_read(ROW_0) && teensypin_read(ROW_1)
+		       && teensypin_read(ROW_2) && teensypin_read(ROW_3)
+		       && teensypin_read(ROW_4) && teensypin_read(ROW_5) );
+	#endif
+}
+
+void teensy_idle_exit(void) {
+	#if TEENSY__DRIVE_ROWS
+		teensypin_write_all_row(DDR, CLEAR);  // set hi-Z (set as input)
+	#elif TEENSY__DRIVE_COLUMNS
+		teensypin_write_all_column(DDR, CLEAR);  // set hi-Z (set as input)
+	#endif
+}
+
+/* suspend
+ * - for while the USB bus is suspended: the same as idle mode, but with the
+ *   LEDs off (they'd be most of our current); whichever LEDs were on are
+ *   turned back on by `teensy_suspend_exit()`
+ */
+static uint8_t _suspend_led_ddrb;
+static uint8_t _suspend_led_portd;
+
+void teensy_suspend_enter(void) {
+	_suspend_led_ddrb  = DDRB  & ((1<<5)|(1<<6)|(1<<7));
+	_suspend_led_portd = PORTD & (1<<6);
+	_kb_led_all_off();
+	teensy_idle_enter();
+}
+
+void teensy_suspend_exit(void) {
+	teensy_idle_exit();
+	DDRB  |= _suspend_led_ddrb;
+	PORTD |= _suspend_led_portd;
+}
+
@@ -13,45 +13,15 @@
 #include "../../../lib/key-functions/public.h"
 #include "../matrix.h"
 #include "../layout.h"
-// FUNCTIONS ------------------------------------------------------------------
-void kbfun_layer_pop_all(void) {
-  kbfun_layer_pop_1();
-  kbfun_layer_pop_2();
-  kbfun_layer_pop_3();
-  kbfun_layer_pop_4();
-  kbfun_layer_pop_5();
-  kbfun_layer_pop_6();
-  kbfun_layer_pop_7();
-  kbfun_layer_pop_8();
-  kbfun_layer_pop_9();
-  kbfun_layer_pop_10();
-}
-
 // DEFINITIONS ----------------------------------------------------------------
 #define  kprrel   &kbfun_press_release
 #define  ktog     &kbfun_toggle
 #define  ktrans   &kbfun_transparent
-#define  lpush1   &kbfun_layer_push_1
-#define  lpush2   &kbfun_layer_push_2
-#define  lpush3   &kbfun_layer_push_3
-#define  lpush4   &kbfun_layer_push_4
-#define  lpush5   &kbfun_layer_push_5
-#define  lpush6   &kbfun_layer_push_6
-#define  lpush7   &kbfun_layer_push_7
-#define  lpush8   &kbfun_layer_push_8
-#define  lpush9   &kbfun_layer_push_9
-#define  lpush10  &kbfun_layer_push_10
-#define  lpop     &kbfun_layer_pop_all
-#define  lpop1    &kbfun_layer_pop_1
-#define  lpop2    &kbfun_layer_pop_2
-#define  lpop3    &kbfun_layer_pop_3
-#define  lpop4    &kbfun_layer_pop_4
-#define  lpop5    &kbfun_layer_pop_5
-#define  lpop6    &kbfun_layer_pop_6
-#define  lpop7    &kbfun_layer_pop_7
-#define  lpop8    &kbfun_layer_pop_8
-#define  lpop9    &kbfun_layer_pop_9
-#define  lpop10   &kbfun_layer_pop_10
+#define  lpush    &kbfun_layer_push
+#define  lsticky  &kbfun_layer_sticky
+#define  lpop     &kbfun_layer_pop
+#define  ltog     &kbfun_layer_toggle
+#define  lpopall  &kbfun_layer_pop_all
 #define  dbtldr   &kbfun_jump_to_bootloader
 #define  sshprre  &kbfun_shift_press_release
 #define  s2kcap   &kbfun_2_keys_capslock_press_release
@@ -61,706 +31,269 @@ void kbfun_layer_pop_all(void) {
 // ----------------------------------------------------------------------------
 
 // LAYOUT ---------------------------------------------------------------------
-const uint8_t PROGMEM _kb_layout[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
-// LAYER 0
-KB_MATRIX_LAYER(
-	// unused
-	0,	
-	// left hand
-	KEY_1_Exclamation,	KEY_2_At,	KEY_3_Pound,	KEY_4_Dollar,	KEY_5_Percent,	KEY_6_Caret,	KEY_Escape,	
-	KEY_Tab,	KEY_q_Q,	KEY_w_W,	KEY_e_E,	KEY_r_R,	KEY_t_T,	KEY_Tab,	
-	KEY_GraveAccent_Tilde,	KEY_a_A,	KEY_s_S,	KEY_d_D,	KEY_f_F,	KEY_g_G,	
-	KEY_LeftShift,	KEY_z_Z,	KEY_x_X,	KEY_c_C,	KEY_v_V,	KEY_b_B,	KEY_DeleteForward,	
-	1,	KEY_LeftArrow,	KEY_UpArrow,	KEY_DownArrow,	KEY_RightArrow,	
-	KEY_LeftGUI,	KEY_LeftAlt,	
-	0,	0,	KEY_LeftControl,	
-	KEY_DeleteBackspace,	KEY_ReturnEnter,	1,	
-	// right hand
-	KEY_Escape,	KEY_7_Ampersand,	KEY_8_Asterisk,	KEY_9_LeftParenthesis,	KEY_0_RightParenthesis,	KEY_Dash_Underscore,	KEY_Equal_Plus,	
-	KEY_PageUp,	KEY_y_Y,	KEY_u_U,	KEY_i_I,	KEY_o_O,	KEY_p_P,	KEY_Backslash_Pipe,	
-	KEY_h_H,	KEY_j_J,	KEY_k_K,	KEY_l_L,	KEY_Semicolon_Colon,	KEY_SingleQuote_DoubleQuote,	
-	KEY_PageDown,	KEY_n_N,	KEY_m_M,	KEY_Comma_LessThan,	KEY_Period_GreaterThan,	KEY_Slash_Question,	KEY_RightShift,	
-	KEY_Home,	KEY_End,	KEY_LeftBracket_LeftBrace,	KEY_RightBracket_RightBrace,	1,	
-	KEY_RightAlt,	KEY_RightGUI,	
-	1,	0,	0,	
-	1,	KEY_ReturnEnter,	KEY_Spacebar	
-),
-// LAYER 1
-KB_MATRIX_LAYER(
-	// unused
-	0,	
-	// left hand
-	KEY_F1,	KEY_F2,	KEY_F3,	KEY_F4,	KEY_F5,	KEY_F6,	0,	
-	KEY_F7,	KEY_F8,	KEY_F9,	KEY_UpArrow,	KEY_F10,	KEY_F11,	KEY_F12,	
-	0,	KEY_LeftBracket_LeftBrace,	KEY_LeftArrow,	KEY_DownArrow,	KEY_RightArrow,	KEY_RightBracket_RightBrace,	
-	KEY_LeftShift,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	
-	KEY_LeftGUI,	KEY_LeftAlt,	
-	0,	0,	KEY_LeftControl,	
-	KEY_DeleteBackspace,	KEY_ReturnEnter,	0,	
-	// right hand
-	KEY_Mute,	KEY_Stop,	KEYPAD_NumLock_Clear,	KEYPAD_Slash,	KEYPAD_Asterisk,	KEYPAD_Minus,	KEY_Power,	
-	KEY_VolumeUp,	MEDIAKEY_NEXT_TRACK,	KEYPAD_7_Home,	KEYPAD_8_UpArrow,	KEYPAD_9_PageUp,	KEYPAD_Plus,	0,	
-	MEDIAKEY_PLAY_PAUSE,	KEYPAD_4_LeftArrow,	KEYPAD_5,	KEYPAD_6_RightArrow,	KEYPAD_Plus,	0,	
-	KEY_VolumeDown,	MEDIAKEY_PREV_TRACK,	KEYPAD_1_End,	KEYPAD_2_DownArrow,	KEYPAD_3_PageDown,	KEYPAD_ENTER,	KEY_RightShift,	
-	KEY_PageUp,	KEY_PageDown,	KEYPAD_Period_Delete,	KEYPAD_ENTER,	0,	
-	KEY_RightAlt,	KEY_RightGUI,	
-	1,	0,	0,	
-	0,	KEY_ReturnEnter,	KEYPAD_0_Insert	
-),
-// LAYER 2
-KB_MATRIX_LAYER(
-	// unused
-	0,	
-	// left hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0,	
-	// right hand
-	0,	0,	KEYPAD_NumLock_Clear,	KEYPAD_Slash,	KEYPAD_Asterisk,	KEYPAD_Minus,	0,	
-	0,	0,	KEYPAD_7_Home,	KEYPAD_8_UpArrow,	KEYPAD_9_PageUp,	KEYPAD_Plus,	0,	
-	0,	KEYPAD_4_LeftArrow,	KEYPAD_5,	KEYPAD_6_RightArrow,	KEYPAD_Plus,	0,	
-	0,	0,	KEYPAD_1_End,	KEYPAD_2_DownArrow,	KEYPAD_3_PageDown,	KEY_ReturnEnter,	0,	
-	0,	0,	KEYPAD_Period_Delete,	KEY_ReturnEnter,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	KEYPAD_0_Insert	
-),
-// LAYER 3
-KB_MATRIX_LAYER(
-	// unused
-	0,	
-	// left hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0,	
-	// right hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0	
-),
-// LAYER 4
-KB_MATRIX_LAYER(
-	// unused
-	0,	
-	// left hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0,	
-	// right hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0	
-),
-// LAYER 5
-KB_MATRIX_LAYER(
-	// unused
-	0,	
-	// left hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0,	
-	// right hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0	
-),
-// LAYER 6
-KB_MATRIX_LAYER(
-	// unused
-	0,	
-	// left hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0,	
-	// right hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0	
-),
-// LAYER 7
-KB_MATRIX_LAYER(
-	// unused
-	0,	
-	// left hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0,	
-	// right hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0	
-),
-// LAYER 8
-KB_MATRIX_LAYER(
-	// unused
-	0,	
-	// left hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0,	
-	// right hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0	
-),
-// LAYER 9
-KB_MATRIX_LAYER(
-	// unused
-	0,	
-	// left hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0,	
-	// right hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0	
-),
+// key kinds: the press and release function of each (see
+// "default--matrix-control.h"); keys are `A(kind, keycode)`
+enum kinds {
+	NONE,
+	KPRREL,
+	LPUSH_LPOP,
+	LPUSH_NONE,
+	DBTLDR_NONE,
+	MPRREL,
+	LPOP_NONE,
 };
-// ----------------------------------------------------------------------------
 
-// PRESS ----------------------------------------------------------------------
-const void_funptr_t PROGMEM _kb_layout_press[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
-// LAYER 0
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	lpush1,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	
-	NULL,	NULL,	kprrel,	
-	kprrel,	kprrel,	lpush1,	
-	// right hand
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	lpush1,	
-	kprrel,	kprrel,	
-	lpush1,	NULL,	NULL,	
-	lpush1,	kprrel,	kprrel	
-),
-// LAYER 1
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	dbtldr,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	NULL,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	kprrel,	kprrel,	
-	NULL,	NULL,	kprrel,	
-	kprrel,	kprrel,	NULL,	
-	// right hand
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	mprrel,	kprrel,	kprrel,	kprrel,	kprrel,	NULL,	
-	mprrel,	kprrel,	kprrel,	kprrel,	kprrel,	NULL,	
-	kprrel,	mprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	NULL,	
-	kprrel,	kprrel,	
-	lpop1,	NULL,	NULL,	
-	NULL,	kprrel,	kprrel	
-),
-// LAYER 2
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	// right hand
-	NULL,	NULL,	kprrel,	kprrel,	kprrel,	kprrel,	NULL,	
-	NULL,	NULL,	kprrel,	kprrel,	kprrel,	kprrel,	NULL,	
-	NULL,	kprrel,	kprrel,	kprrel,	kprrel,	NULL,	
-	NULL,	NULL,	kprrel,	kprrel,	kprrel,	kprrel,	NULL,	
-	NULL,	NULL,	kprrel,	kprrel,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	kprrel	
-),
-// LAYER 3
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	// right hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL	
-),
-// LAYER 4
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	// right hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL	
-),
-// LAYER 5
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	// right hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL	
-),
-// LAYER 6
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	// right hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL	
-),
-// LAYER 7
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	// right hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL	
-),
-// LAYER 8
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	// right hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL	
-),
-// LAYER 9
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	// right hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL	
-),
+const kb_layout_kind_t PROGMEM _kb_layout_kinds[] = {
+	[NONE]        = { NULL,   NULL },
+	[KPRREL]      = { kprrel, kprrel },
+	[LPUSH_LPOP]  = { lpush,  lpop },
+	[LPUSH_NONE]  = { lpush,  NULL },
+	[DBTLDR_NONE] = { dbtldr, NULL },
+	[MPRREL]      = { mprrel, mprrel },
+	[LPOP_NONE]   = { lpop,   NULL },
 };
+
+#define  A(kind, keycode)  KB_LAYOUT_ACTION(kind, keycode)
+
 // ----------------------------------------------------------------------------
+// ----------------------------------------------------------------------------
+
+const uint16_t PROGMEM _kb_layout[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
+
+	KB_MATRIX_LAYER(  // layer 0
+// unused
+0,
+// left hand
+    A(KPRREL, KEY_1_Exclamation),        A(KPRREL, KEY_2_At),     A(KPRREL, KEY_3_Pound),  A(KPRREL, KEY_4_Dollar),  A(KPRREL, KEY_5_Percent), A(KPRREL, KEY_6_Caret),        A(KPRREL, KEY_Escape),
+              A(KPRREL, KEY_Tab),         A(KPRREL, KEY_q_Q),         A(KPRREL, KEY_w_W),       A(KPRREL, KEY_e_E),        A(KPRREL, KEY_r_R),     A(KPRREL, KEY_t_T),           A(KPRREL, KEY_Tab),
+A(KPRREL, KEY_GraveAccent_Tilde),         A(KPRREL, KEY_a_A),         A(KPRREL, KEY_s_S),       A(KPRREL, KEY_d_D),        A(KPRREL, KEY_f_F),     A(KPRREL, KEY_g_G),
+        A(KPRREL, KEY_LeftShift),         A(KPRREL, KEY_z_Z),         A(KPRREL, KEY_x_X),       A(KPRREL, KEY_c_C),        A(KPRREL, KEY_v_V),     A(KPRREL, KEY_b_B), A(KPRREL, KEY_DeleteForward),
+                A(LPUSH_LPOP, 1),   A(KPRREL, KEY_LeftArrow),     A(KPRREL, KEY_UpArrow), A(KPRREL, KEY_DownArrow), A(KPRREL, KEY_RightArrow),
+          A(KPRREL, KEY_LeftGUI),     A(KPRREL, KEY_LeftAlt),
+                               0,                          0, A(KPRREL, KEY_LeftControl),
+  A(KPRREL, KEY_DeleteBackspace), A(KPRREL, KEY_ReturnEnter),           A(LPUSH_LPOP, 1),
+// right hand
+  A(KPRREL, KEY_Escape), A(KPRREL, KEY_7_Ampersand),            A(KPRREL, KEY_8_Asterisk),       A(KPRREL, KEY_9_LeftParenthesis), A(KPRREL, KEY_0_RightParenthesis),         A(KPRREL, KEY_Dash_Underscore),     A(KPRREL, KEY_Equal_Plus),
+  A(KPRREL, KEY_PageUp),         A(KPRREL, KEY_y_Y),                   A(KPRREL, KEY_u_U),                     A(KPRREL, KEY_i_I),                A(KPRREL, KEY_o_O),                     A(KPRREL, KEY_p_P), A(KPRREL, KEY_Backslash_Pipe),
+     A(KPRREL, KEY_h_H),         A(KPRREL, KEY_j_J),                   A(KPRREL, KEY_k_K),                     A(KPRREL, KEY_l_L),    A(KPRREL, KEY_Semicolon_Colon), A(KPRREL, KEY_SingleQuote_DoubleQuote),
+A(KPRREL, KEY_PageDown),         A(KPRREL, KEY_n_N),                   A(KPRREL, KEY_m_M),          A(KPRREL, KEY_Comma_LessThan), A(KPRREL, KEY_Period_GreaterThan),          A(KPRREL, KEY_Slash_Question),     A(KPRREL, KEY_RightShift),
+    A(KPRREL, KEY_Home),         A(KPRREL, KEY_End), A(KPRREL, KEY_LeftBracket_LeftBrace), A(KPRREL, KEY_RightBracket_RightBrace),                  A(LPUSH_LPOP, 1),
+A(KPRREL, KEY_RightAlt),    A(KPRREL, KEY_RightGUI),
+       A(LPUSH_NONE, 1),                          0,                                    0,
+       A(LPUSH_LPOP, 1), A(KPRREL, KEY_ReturnEnter),              A(KPRREL, KEY_Spacebar) ),
+
+
+	KB_MATRIX_LAYER(  // layer 1
+// unused
+0,
+// left hand
+             A(KPRREL, KEY_F1),                    A(KPRREL, KEY_F2),          A(KPRREL, KEY_F3),        A(KPRREL, KEY_F4),         A(KPRREL, KEY_F5),                      A(KPRREL, KEY_F6),  A(DBTLDR_NONE, 0),
+             A(KPRREL, KEY_F7),                    A(KPRREL, KEY_F8),          A(KPRREL, KEY_F9),   A(KPRREL, KEY_UpArrow),        A(KPRREL, KEY_F10),                     A(KPRREL, KEY_F11), A(KPRREL, KEY_F12),
+                             0, A(KPRREL, KEY_LeftBracket_LeftBrace),   A(KPRREL, KEY_LeftArrow), A(KPRREL, KEY_DownArrow), A(KPRREL, KEY_RightArrow), A(KPRREL, KEY_RightBracket_RightBrace),
+      A(KPRREL, KEY_LeftShift),                                    0,                          0,                        0,                         0,                                      0,                  0,
+                             0,                                    0,                          0,                        0,                         0,
+        A(KPRREL, KEY_LeftGUI),               A(KPRREL, KEY_LeftAlt),
+                             0,                                    0, A(KPRREL, KEY_LeftControl),
+A(KPRREL, KEY_DeleteBackspace),           A(KPRREL, KEY_ReturnEnter),                          0,
+// right hand
+           A(KPRREL, KEY_Mute),            A(KPRREL, KEY_Stop), A(KPRREL, KEYPAD_NumLock_Clear),        A(KPRREL, KEYPAD_Slash),   A(KPRREL, KEYPAD_Asterisk), A(KPRREL, KEYPAD_Minus),      A(KPRREL, KEY_Power),
+       A(KPRREL, KEY_VolumeUp), A(MPRREL, MEDIAKEY_NEXT_TRACK),        A(KPRREL, KEYPAD_7_Home),    A(KPRREL, KEYPAD_8_UpArrow),   A(KPRREL, KEYPAD_9_PageUp),  A(KPRREL, KEYPAD_Plus),                         0,
+A(MPRREL, MEDIAKEY_PLAY_PAUSE),  A(KPRREL, KEYPAD_4_LeftArrow),             A(KPRREL, KEYPAD_5), A(KPRREL, KEYPAD_6_RightArrow),       A(KPRREL, KEYPAD_Plus),                       0,
+     A(KPRREL, KEY_VolumeDown), A(MPRREL, MEDIAKEY_PREV_TRACK),         A(KPRREL, KEYPAD_1_End),  A(KPRREL, KEYPAD_2_DownArrow), A(KPRREL, KEYPAD_3_PageDown), A(KPRREL, KEYPAD_ENTER), A(KPRREL, KEY_RightShift),
+         A(KPRREL, KEY_PageUp),        A(KPRREL, KEY_PageDown), A(KPRREL, KEYPAD_Period_Delete),        A(KPRREL, KEYPAD_ENTER),                            0,
+       A(KPRREL, KEY_RightAlt),        A(KPRREL, KEY_RightGUI),
+               A(LPOP_NONE, 1),                              0,                               0,
+                             0,     A(KPRREL, KEY_ReturnEnter),      A(KPRREL, KEYPAD_0_Insert) ),
+
+
+	KB_MATRIX_LAYER(  // layer 2
+// unused
+0,
+// left hand
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0,
+0, 0,
+0, 0, 0,
+0, 0, 0,
+// right hand
+0,                             0, A(KPRREL, KEYPAD_NumLock_Clear),        A(KPRREL, KEYPAD_Slash),   A(KPRREL, KEYPAD_Asterisk),    A(KPRREL, KEYPAD_Minus), 0,
+0,                             0,        A(KPRREL, KEYPAD_7_Home),    A(KPRREL, KEYPAD_8_UpArrow),   A(KPRREL, KEYPAD_9_PageUp),     A(KPRREL, KEYPAD_Plus), 0,
+0, A(KPRREL, KEYPAD_4_LeftArrow),             A(KPRREL, KEYPAD_5), A(KPRREL, KEYPAD_6_RightArrow),       A(KPRREL, KEYPAD_Plus),                          0,
+0,                             0,         A(KPRREL, KEYPAD_1_End),  A(KPRREL, KEYPAD_2_DownArrow), A(KPRREL, KEYPAD_3_PageDown), A(KPRREL, KEY_ReturnEnter), 0,
+0,                             0, A(KPRREL, KEYPAD_Period_Delete),     A(KPRREL, KEY_ReturnEnter),                            0,
+0,                             0,
+0,                             0,                               0,
+0,                             0,      A(KPRREL, KEYPAD_0_Insert) ),
+
+
+	KB_MATRIX_LAYER(  // layer 3
+// unused
+0,
+// left hand
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0,
+0, 0,
+0, 0, 0,
+0, 0, 0,
+// right hand
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0,
+0, 0,
+0, 0, 0,
+0, 0, 0 ),
+
+
+	KB_MATRIX_LAYER(  // layer 4
+// unused
+0,
+// left hand
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0,
+0, 0,
+0, 0, 0,
+0, 0, 0,
+// right hand
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0,
+0, 0,
+0, 0, 0,
+0, 0, 0 ),
+
+
+	KB_MATRIX_LAYER(  // layer 5
+// unused
+0,
+// left hand
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0,
+0, 0,
+0, 0, 0,
+0, 0, 0,
+// right hand
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0,
+0, 0,
+0, 0, 0,
+0, 0, 0 ),
+
+
+	KB_MATRIX_LAYER(  // layer 6
+// unused
+0,
+// left hand
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0,
+0, 0,
+0, 0, 0,
+0, 0, 0,
+// right hand
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0,
+0, 0,
+0, 0, 0,
+0, 0, 0 ),
+
+
+	KB_MATRIX_LAYER(  // layer 7
+// unused
+0,
+// left hand
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0,
+0, 0,
+0, 0, 0,
+0, 0, 0,
+// right hand
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0,
+0, 0,
+0, 0, 0,
+0, 0, 0 ),
+
+
+	KB_MATRIX_LAYER(  // layer 8
+// unused
+0,
+// left hand
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0,
+0, 0,
+0, 0, 0,
+0, 0, 0,
+// right hand
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0,
+0, 0,
+0, 0, 0,
+0, 0, 0 ),
+
+
+	KB_MATRIX_LAYER(  // layer 9
+// unused
+0,
+// left hand
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0,
+0, 0,
+0, 0, 0,
+0, 0, 0,
+// right hand
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0, 0, 0,
+0, 0, 0, 0, 0,
+0, 0,
+0, 0, 0,
+0, 0, 0 ),
 
-// RELEASE --------------------------------------------------------------------
-const void_funptr_t PROGMEM _kb_layout_release[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
-// LAYER 0
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	lpop1,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	
-	NULL,	NULL,	kprrel,	
-	kprrel,	kprrel,	lpop1,	
-	// right hand
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	lpop1,	
-	kprrel,	kprrel,	
-	NULL,	NULL,	NULL,	
-	lpop1,	kprrel,	kprrel	
-),
-// LAYER 1
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	NULL,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	NULL,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	kprrel,	kprrel,	
-	NULL,	NULL,	kprrel,	
-	kprrel,	kprrel,	NULL,	
-	// right hand
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	mprrel,	kprrel,	kprrel,	kprrel,	kprrel,	NULL,	
-	mprrel,	kprrel,	kprrel,	kprrel,	kprrel,	NULL,	
-	kprrel,	mprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	NULL,	
-	kprrel,	kprrel,	
-	NULL,	NULL,	NULL,	
-	NULL,	kprrel,	kprrel	
-),
-// LAYER 2
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	// right hand
-	NULL,	NULL,	kprrel,	kprrel,	kprrel,	kprrel,	NULL,	
-	NULL,	NULL,	kprrel,	kprrel,	kprrel,	kprrel,	NULL,	
-	NULL,	kprrel,	kprrel,	kprrel,	kprrel,	NULL,	
-	NULL,	NULL,	kprrel,	kprrel,	kprrel,	kprrel,	NULL,	
-	NULL,	NULL,	kprrel,	kprrel,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	kprrel	
-),
-// LAYER 3
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	// right hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL	
-),
-// LAYER 4
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	// right hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL	
-),
-// LAYER 5
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	// right hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL	
-),
-// LAYER 6
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	// right hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL	
-),
-// LAYER 7
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	// right hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL	
-),
-// LAYER 8
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	// right hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL	
-),
-// LAYER 9
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	// right hand
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL,	NULL,	NULL,	
-	NULL,	NULL,	
-	NULL,	NULL,	NULL,	
-	NULL,	NULL,	NULL	
-),
 };
+
+// the sparse form of `_kb_layout` (see "default--matrix-control.h")
+#if KB_LAYOUT_SPARSE
+	#include "./boli--layout--sparse.h"
+#endif
+
 // ----------------------------------------------------------------------------
@@ -45,254 +45,127 @@
 #include "../../../lib/key-functions/public.h"
 #include "../matrix.h"
 #include "../layout.h"
-// FUNCTIONS ------------------------------------------------------------------
-void kbfun_layer_pop_all(void) {
-  kbfun_layer_pop_1();
-  kbfun_layer_pop_2();
-  kbfun_layer_pop_3();
-  kbfun_layer_pop_4();
-  kbfun_layer_pop_5();
-  kbfun_layer_pop_6();
-  kbfun_layer_pop_7();
-  kbfun_layer_pop_8();
-  kbfun_layer_pop_9();
-  kbfun_layer_pop_10();
-}
-
 // DEFINITIONS ----------------------------------------------------------------
 #define  kprrel   &kbfun_press_release
 #define  kprpst   &kbfun_press_release_preserve_sticky
 #define  mprrel   &kbfun_mediakey_press_release
 #define  ktrans   &kbfun_transparent
-#define  lpush1   &kbfun_layer_push_1
-#define  lpush2   &kbfun_layer_push_2
-#define  lsticky1   &kbfun_layer_sticky_1
-#define  lsticky2   &kbfun_layer_sticky_2
-#define  lpop     &kbfun_layer_pop_all
-#define  lpop1    &kbfun_layer_pop_1
-#define  lpop2    &kbfun_layer_pop_2
+#define  lpush    &kbfun_layer_push
+#define  lsticky  &kbfun_layer_sticky
+#define  lpop     &kbfun_layer_pop
+#define  ltog     &kbfun_layer_toggle
+#define  lpopall  &kbfun_layer_pop_all
 #define  dbtldr   &kbfun_jump_to_bootloader
 #define  sshprre  &kbfun_shift_press_release
 // ----------------------------------------------------------------------------
 
 // LAYOUT ---------------------------------------------------------------------
-const uint8_t PROGMEM _kb_layout[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
-// LAYER 0
-KB_MATRIX_LAYER(
-	// unused
-	0,	
-	// left hand
-	KEY_GraveAccent_Tilde,	KEY_1_Exclamation,	KEY_2_At,	KEY_3_Pound,	KEY_4_Dollar,	KEY_5_Percent,	KEY_LeftBracket_LeftBrace,	
-	KEY_LeftControl,	KEY_q_Q,	KEY_w_W,	KEY_f_F,	KEY_p_P,	KEY_g_G,	KEY_Equal_Plus,	
-	KEY_LeftShift,	KEY_a_A,	KEY_r_R,	KEY_s_S,	KEY_t_T,	KEY_d_D,	
-	KEY_LeftGUI,	KEY_z_Z,	KEY_x_X,	KEY_c_C,	KEY_v_V,	KEY_b_B,	0,	
-	KEY_Home,	KEY_End,	KEY_PageUp,	KEY_PageDown,	1,
-	KEY_Tab,	KEY_Spacebar,	
-	0,	0,	KEY_ReturnEnter,	
-	KEY_Escape,	2,	KEY_LeftAlt,	
-	// right hand
-	KEY_RightBracket_RightBrace,	KEY_6_Caret,	KEY_7_Ampersand,	KEY_8_Asterisk,	KEY_9_LeftParenthesis,	KEY_0_RightParenthesis,	KEY_Backslash_Pipe,	
-	KEY_Dash_Underscore,	KEY_j_J,	KEY_l_L,	KEY_u_U,	KEY_y_Y,	KEY_Semicolon_Colon,	KEY_RightControl,	
-	KEY_h_H,	KEY_n_N,	KEY_e_E,	KEY_i_I,	KEY_o_O,	KEY_RightShift,	
-	2,	KEY_k_K,	KEY_m_M,	KEY_Comma_LessThan,	KEY_Period_GreaterThan,	KEY_Slash_Question,	KEY_RightGUI,	
-	1,	KEY_DownArrow,	KEY_UpArrow,	KEY_LeftArrow,	KEY_RightArrow,
-	KEY_Insert,	KEY_DeleteForward,	
-	0,	0,	0,	
-	KEY_DeleteBackspace,	KEY_ReturnEnter,	KEY_Spacebar	
-),
-// LAYER 1
-KB_MATRIX_LAYER(
-	// unused
-	0,	
-	// left hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	KEY_1_Exclamation,	KEY_2_At,	KEY_3_Pound,	KEY_4_Dollar,	KEY_5_Percent,	0,	
-	0,	KEY_SingleQuote_DoubleQuote,	0x34,	0x2F,	0x30,	KEY_Equal_Plus,	
-	0,	0x31,	KEY_Backslash_Pipe,	KEY_Dash_Underscore,	KEY_DeleteBackspace,	KEY_Tab,	0,	
-	KEY_LeftArrow,	KEY_RightArrow,	KEY_UpArrow,	KEY_DownArrow,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0,	
-	// right hand
-	0,	0,	MEDIAKEY_PREV_TRACK,	MEDIAKEY_PLAY_PAUSE,	MEDIAKEY_NEXT_TRACK,	0,	0,	
-	0,	KEY_6_Caret,	KEY_7_Ampersand,	KEYPAD_Asterisk,	KEYPAD_Minus,	KEY_GraveAccent_Tilde,	0,	
-	KEYPAD_Plus,	KEY_9_LeftParenthesis,	KEY_0_RightParenthesis,	KEY_LeftBracket_LeftBrace,	KEY_RightBracket_RightBrace,	0,	
-	0,	KEY_GraveAccent_Tilde,	KEY_DownArrow,	KEY_UpArrow,	KEY_LeftArrow,	KEY_RightArrow,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0	
-),
-// LAYER 2
-KB_MATRIX_LAYER(
-	// unused
-	0,	
-	// left hand
-	0,	0,	0,	0,	0,	0,	0,	
-	0,	KEY_F9,	KEY_F10,	KEY_F11,	KEY_F12,	KEY_VolumeUp,	0,	
-	0,	KEY_F5,	KEY_F6,	KEY_F7,	KEY_F8,	KEY_VolumeDown,	
-	0,	KEY_F1,	KEY_F2,	KEY_F3,	KEY_F4,	KEY_Mute,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0,	
-	// right hand
-	0,	0,	KEYPAD_NumLock_Clear,	KEYPAD_Asterisk,	KEYPAD_Slash,	KEY_5_Percent,	0,	
-	0,	KEYPAD_Minus,	KEYPAD_7_Home,	KEYPAD_8_UpArrow,	KEYPAD_9_PageUp,	KEYPAD_Plus,	0,	
-	KEYPAD_Equal,	KEYPAD_4_LeftArrow,	KEYPAD_5,	KEYPAD_6_RightArrow,	KEYPAD_0_Insert,	0,	
-	0,	KEY_Comma_LessThan,	KEYPAD_1_End,	KEYPAD_2_DownArrow,	KEYPAD_3_PageDown,	KEYPAD_Period_Delete,	0,	
-	0,	0,	0,	0,	0,	
-	0,	0,	
-	0,	0,	0,	
-	0,	0,	0	
-),
+// key kinds: the press and release function of each (see
+// "default--matrix-control.h"); keys are `A(kind, keycode)`
+enum kinds {
+	NONE,
+	KPRREL,
+	LPOPALL_NONE,
+	LSTICKY,
+	KTRANS,
+	SSHPRRE,
+	KTRANS_KPRREL,
+	MPRREL,
+	DBTLDR_NONE,
 };
-// ----------------------------------------------------------------------------
 
-// PRESS ----------------------------------------------------------------------
-const void_funptr_t PROGMEM _kb_layout_press[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
-// LAYER 0
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	lpop,	
-	kprrel,	kprrel,	kprrel,	kprrel,	lsticky1,	
-	kprrel,	kprrel,	
-	NULL,	NULL,	kprrel,	
-	kprrel,	lsticky2,	kprrel,	
-	// right hand
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	lsticky2,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	lsticky1,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	
-	lpop,	NULL,	NULL,	
-	kprrel,	kprrel,	kprrel	
-),
-// LAYER 1
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	
-	ktrans,	sshprre,	sshprre,	sshprre,	sshprre,	sshprre,	ktrans,	
-	ktrans,	kprrel,	sshprre,	sshprre,	sshprre,	kprrel,	
-	ktrans,	sshprre,	kprrel,	sshprre,	kprrel,	kprrel,	ktrans,	
-	kprrel,	kprrel,	kprrel,	kprrel,	ktrans,	
-	ktrans,	ktrans,	
-	NULL,	NULL,	ktrans,	
-	ktrans,	ktrans,	ktrans,	
-	// right hand
-	ktrans,	ktrans,	mprrel,	mprrel,	mprrel,	ktrans,	ktrans,	
-	ktrans,	sshprre,	sshprre,	kprrel,	kprrel,	kprrel,	ktrans,	
-	kprrel,	sshprre,	sshprre,	kprrel,	kprrel,	ktrans,	
-	ktrans,	sshprre,	kprrel,	kprrel,	kprrel,	kprrel,	ktrans,	
-	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	
-	ktrans,	ktrans,	
-	ktrans,	NULL,	NULL,	
-	ktrans,	ktrans,	ktrans	
-),
-// LAYER 2
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	
-	ktrans,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	ktrans,	
-	ktrans,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	ktrans,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	ktrans,	
-	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	
-	ktrans,	ktrans,	
-	NULL,	NULL,	ktrans,	
-	ktrans,	ktrans,	ktrans,	
-	// right hand
-	dbtldr,	kprrel,	kprrel,	kprrel,	kprrel,	sshprre,	ktrans,	
-	ktrans,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	ktrans,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	ktrans,	
-	ktrans,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	ktrans,	
-	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	
-	ktrans,	ktrans,	
-	ktrans,	NULL,	NULL,	
-	ktrans,	ktrans,	ktrans	
-),
+const kb_layout_kind_t PROGMEM _kb_layout_kinds[] = {
+	[NONE]          = { NULL,    NULL },
+	[KPRREL]        = { kprrel,  kprrel },
+	[LPOPALL_NONE]  = { lpopall, NULL },
+	[LSTICKY]       = { lsticky, lsticky },
+	[KTRANS]        = { ktrans,  ktrans },
+	[SSHPRRE]       = { sshprre, sshprre },
+	[KTRANS_KPRREL] = { ktrans,  kprrel },
+	[MPRREL]        = { mprrel,  mprrel },
+	[DBTLDR_NONE]   = { dbtldr,  NULL },
 };
+
+#define  A(kind, keycode)  KB_LAYOUT_ACTION(kind, keycode)
+
 // ----------------------------------------------------------------------------
+// ----------------------------------------------------------------------------
+
+const uint16_t PROGMEM _kb_layout[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
+
+	KB_MATRIX_LAYER(  // layer 0
+// unused
+0,
+// left hand
+A(KPRREL, KEY_GraveAccent_Tilde), A(KPRREL, KEY_1_Exclamation),        A(KPRREL, KEY_2_At),  A(KPRREL, KEY_3_Pound), A(KPRREL, KEY_4_Dollar), A(KPRREL, KEY_5_Percent), A(KPRREL, KEY_LeftBracket_LeftBrace),
+      A(KPRREL, KEY_LeftControl),           A(KPRREL, KEY_q_Q),         A(KPRREL, KEY_w_W),      A(KPRREL, KEY_f_F),      A(KPRREL, KEY_p_P),       A(KPRREL, KEY_g_G),            A(KPRREL, KEY_Equal_Plus),
+        A(KPRREL, KEY_LeftShift),           A(KPRREL, KEY_a_A),         A(KPRREL, KEY_r_R),      A(KPRREL, KEY_s_S),      A(KPRREL, KEY_t_T),       A(KPRREL, KEY_d_D),
+          A(KPRREL, KEY_LeftGUI),           A(KPRREL, KEY_z_Z),         A(KPRREL, KEY_x_X),      A(KPRREL, KEY_c_C),      A(KPRREL, KEY_v_V),       A(KPRREL, KEY_b_B),                   A(LPOPALL_NONE, 0),
+             A(KPRREL, KEY_Home),           A(KPRREL, KEY_End),      A(KPRREL, KEY_PageUp), A(KPRREL, KEY_PageDown),           A(LSTICKY, 1),
+              A(KPRREL, KEY_Tab),      A(KPRREL, KEY_Spacebar),
+                               0,                            0, A(KPRREL, KEY_ReturnEnter),
+           A(KPRREL, KEY_Escape),                A(LSTICKY, 2),     A(KPRREL, KEY_LeftAlt),
+// right hand
+A(KPRREL, KEY_RightBracket_RightBrace),       A(KPRREL, KEY_6_Caret), A(KPRREL, KEY_7_Ampersand),     A(KPRREL, KEY_8_Asterisk),  A(KPRREL, KEY_9_LeftParenthesis), A(KPRREL, KEY_0_RightParenthesis), A(KPRREL, KEY_Backslash_Pipe),
+        A(KPRREL, KEY_Dash_Underscore),           A(KPRREL, KEY_j_J),         A(KPRREL, KEY_l_L),            A(KPRREL, KEY_u_U),                A(KPRREL, KEY_y_Y),    A(KPRREL, KEY_Semicolon_Colon),   A(KPRREL, KEY_RightControl),
+                    A(KPRREL, KEY_h_H),           A(KPRREL, KEY_n_N),         A(KPRREL, KEY_e_E),            A(KPRREL, KEY_i_I),                A(KPRREL, KEY_o_O),         A(KPRREL, KEY_RightShift),
+                         A(LSTICKY, 2),           A(KPRREL, KEY_k_K),         A(KPRREL, KEY_m_M), A(KPRREL, KEY_Comma_LessThan), A(KPRREL, KEY_Period_GreaterThan),     A(KPRREL, KEY_Slash_Question),       A(KPRREL, KEY_RightGUI),
+                         A(LSTICKY, 1),     A(KPRREL, KEY_DownArrow),     A(KPRREL, KEY_UpArrow),      A(KPRREL, KEY_LeftArrow),         A(KPRREL, KEY_RightArrow),
+                 A(KPRREL, KEY_Insert), A(KPRREL, KEY_DeleteForward),
+                    A(LPOPALL_NONE, 0),                            0,                          0,
+        A(KPRREL, KEY_DeleteBackspace),   A(KPRREL, KEY_ReturnEnter),    A(KPRREL, KEY_Spacebar) ),
+
+
+	KB_MATRIX_LAYER(  // layer 1
+// unused
+0,
+// left hand
+            A(KTRANS, 0),                           A(KTRANS, 0),                  A(KTRANS, 0),                    A(KTRANS, 0),                   A(KTRANS, 0),              A(KTRANS, 0), A(KTRANS, 0),
+            A(KTRANS, 0),          A(SSHPRRE, KEY_1_Exclamation),          A(SSHPRRE, KEY_2_At),         A(SSHPRRE, KEY_3_Pound),       A(SSHPRRE, KEY_4_Dollar), A(SSHPRRE, KEY_5_Percent), A(KTRANS, 0),
+            A(KTRANS, 0), A(KPRREL, KEY_SingleQuote_DoubleQuote),              A(SSHPRRE, 0x34),                A(SSHPRRE, 0x2F),               A(SSHPRRE, 0x30), A(KPRREL, KEY_Equal_Plus),
+     A(KTRANS_KPRREL, 0),                       A(SSHPRRE, 0x31), A(KPRREL, KEY_Backslash_Pipe), A(SSHPRRE, KEY_Dash_Underscore), A(KPRREL, KEY_DeleteBackspace),        A(KPRREL, KEY_Tab), A(KTRANS, 0),
+A(KPRREL, KEY_LeftArrow),              A(KPRREL, KEY_RightArrow),        A(KPRREL, KEY_UpArrow),        A(KPRREL, KEY_DownArrow),                   A(KTRANS, 0),
+            A(KTRANS, 0),                           A(KTRANS, 0),
+                       0,                                      0,                  A(KTRANS, 0),
+            A(KTRANS, 0),                           A(KTRANS, 0),                  A(KTRANS, 0),
+// right hand
+          A(KTRANS, 0),                      A(KTRANS, 0),     A(MPRREL, MEDIAKEY_PREV_TRACK),       A(MPRREL, MEDIAKEY_PLAY_PAUSE),         A(MPRREL, MEDIAKEY_NEXT_TRACK),                     A(KTRANS, 0), A(KTRANS, 0),
+          A(KTRANS, 0),           A(SSHPRRE, KEY_6_Caret),        A(SSHPRRE, KEY_7_Ampersand),           A(KPRREL, KEYPAD_Asterisk),                A(KPRREL, KEYPAD_Minus), A(KPRREL, KEY_GraveAccent_Tilde), A(KTRANS, 0),
+A(KPRREL, KEYPAD_Plus), A(SSHPRRE, KEY_9_LeftParenthesis), A(SSHPRRE, KEY_0_RightParenthesis), A(KPRREL, KEY_LeftBracket_LeftBrace), A(KPRREL, KEY_RightBracket_RightBrace),                     A(KTRANS, 0),
+          A(KTRANS, 0), A(SSHPRRE, KEY_GraveAccent_Tilde),           A(KPRREL, KEY_DownArrow),               A(KPRREL, KEY_UpArrow),               A(KPRREL, KEY_LeftArrow),        A(KPRREL, KEY_RightArrow), A(KTRANS, 0),
+          A(KTRANS, 0),                      A(KTRANS, 0),                       A(KTRANS, 0),                         A(KTRANS, 0),                           A(KTRANS, 0),
+          A(KTRANS, 0),                      A(KTRANS, 0),
+          A(KTRANS, 0),                                 0,                                  0,
+          A(KTRANS, 0),                      A(KTRANS, 0),                       A(KTRANS, 0) ),
+
+
+	KB_MATRIX_LAYER(  // layer 2
+// unused
+0,
+// left hand
+       A(KTRANS, 0),      A(KTRANS, 0),       A(KTRANS, 0),       A(KTRANS, 0),       A(KTRANS, 0),              A(KTRANS, 0), A(KTRANS, 0),
+       A(KTRANS, 0), A(KPRREL, KEY_F9), A(KPRREL, KEY_F10), A(KPRREL, KEY_F11), A(KPRREL, KEY_F12),   A(KPRREL, KEY_VolumeUp), A(KTRANS, 0),
+       A(KTRANS, 0), A(KPRREL, KEY_F5),  A(KPRREL, KEY_F6),  A(KPRREL, KEY_F7),  A(KPRREL, KEY_F8), A(KPRREL, KEY_VolumeDown),
+A(KTRANS_KPRREL, 0), A(KPRREL, KEY_F1),  A(KPRREL, KEY_F2),  A(KPRREL, KEY_F3),  A(KPRREL, KEY_F4),       A(KPRREL, KEY_Mute), A(KTRANS, 0),
+       A(KTRANS, 0),      A(KTRANS, 0),       A(KTRANS, 0),       A(KTRANS, 0),       A(KTRANS, 0),
+       A(KTRANS, 0),      A(KTRANS, 0),
+                  0,                 0,       A(KTRANS, 0),
+A(KTRANS_KPRREL, 0),      A(KTRANS, 0),       A(KTRANS, 0),
+// right hand
+      A(DBTLDR_NONE, 0),                  A(KPRREL, 0), A(KPRREL, KEYPAD_NumLock_Clear),     A(KPRREL, KEYPAD_Asterisk),      A(KPRREL, KEYPAD_Slash),       A(SSHPRRE, KEY_5_Percent),        A(KTRANS, 0),
+           A(KTRANS, 0),       A(KPRREL, KEYPAD_Minus),        A(KPRREL, KEYPAD_7_Home),    A(KPRREL, KEYPAD_8_UpArrow),   A(KPRREL, KEYPAD_9_PageUp),          A(KPRREL, KEYPAD_Plus),        A(KTRANS, 0),
+A(KPRREL, KEYPAD_Equal), A(KPRREL, KEYPAD_4_LeftArrow),             A(KPRREL, KEYPAD_5), A(KPRREL, KEYPAD_6_RightArrow),   A(KPRREL, KEYPAD_0_Insert),                    A(KTRANS, 0),
+           A(KTRANS, 0), A(KPRREL, KEY_Comma_LessThan),         A(KPRREL, KEYPAD_1_End),  A(KPRREL, KEYPAD_2_DownArrow), A(KPRREL, KEYPAD_3_PageDown), A(KPRREL, KEYPAD_Period_Delete), A(KTRANS_KPRREL, 0),
+           A(KTRANS, 0),                  A(KTRANS, 0),                    A(KTRANS, 0),                   A(KTRANS, 0),                 A(KTRANS, 0),
+           A(KTRANS, 0),                  A(KTRANS, 0),
+           A(KTRANS, 0),                             0,                               0,
+           A(KTRANS, 0),                  A(KTRANS, 0),                    A(KTRANS, 0) ),
 
-// RELEASE --------------------------------------------------------------------
-const void_funptr_t PROGMEM _kb_layout_release[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
-// LAYER 0
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	NULL,	
-	kprrel,	kprrel,	kprrel,	kprrel,	lsticky1,	
-	kprrel,	kprrel,	
-	NULL,	NULL,	kprrel,	
-	kprrel,	lsticky2,	kprrel,	
-	// right hand
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	lsticky2,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	lsticky1,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	
-	NULL,	NULL,	NULL,	
-	kprrel,	kprrel,	kprrel	
-),
-// LAYER 1
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	
-	ktrans,	sshprre,	sshprre,	sshprre,	sshprre,	sshprre,	ktrans,	
-	ktrans,	kprrel,	sshprre,	sshprre,	sshprre,	kprrel,	
-	kprrel,	sshprre,	kprrel,	sshprre,	kprrel,	kprrel,	ktrans,	
-	kprrel,	kprrel,	kprrel,	kprrel,	ktrans,	
-	ktrans,	ktrans,	
-	NULL,	NULL,	ktrans,	
-	ktrans,	ktrans,	ktrans,	
-	// right hand
-	ktrans,	ktrans,	mprrel,	mprrel,	mprrel,	ktrans,	ktrans,	
-	ktrans,	sshprre,	sshprre,	kprrel,	kprrel,	kprrel,	ktrans,	
-	kprrel,	sshprre,	sshprre,	kprrel,	kprrel,	ktrans,	
-	ktrans,	sshprre,	kprrel,	kprrel,	kprrel,	kprrel,	ktrans,	
-	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	
-	ktrans,	ktrans,	
-	ktrans,	NULL,	NULL,	
-	ktrans,	ktrans,	ktrans	
-),
-// LAYER 2
-KB_MATRIX_LAYER(
-	// unused
-	NULL,	
-	// left hand
-	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	
-	ktrans,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	ktrans,	
-	ktrans,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	ktrans,	
-	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	
-	ktrans,	ktrans,	
-	NULL,	NULL,	ktrans,	
-	kprrel,	ktrans,	ktrans,	
-	// right hand
-	NULL,	kprrel,	kprrel,	kprrel,	kprrel,	sshprre,	ktrans,	
-	ktrans,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	ktrans,	
-	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	ktrans,	
-	ktrans,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	kprrel,	
-	ktrans,	ktrans,	ktrans,	ktrans,	ktrans,	
-	ktrans,	ktrans,	
-	ktrans,	NULL,	NULL,	
-	ktrans,	ktrans,	ktrans	
-),
 };
+
+// the sparse form of `_kb_layout` (see "default--matrix-control.h")
+#if KB_LAYOUT_SPARSE
+	#include "./colemak-jc-mod--sparse.h"
+#endif
+
 // ----------------------------------------------------------------------------
@@ -21,108 +21,6 @@
 // ----------------------------------------------------------------------------
 // ----------------------------------------------------------------------------
 
-const uint8_t PROGMEM _kb_layout[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
-    // LAYOUT L0: COLEMAK
-    KB_MATRIX_LAYER( 0,
-    // left hand
-    _equal,     _1,         _2,         _3,         _4,         _5,         2,
-    _tab,       _Q,         _W,         _F,         _P,         _G,         _esc,
-    _ctrlL,     _A,         _R,         _S,         _T,         _D,
-    _shiftL,    _Z,         _X,         _C,         _V,         _B,         2,
-    _guiL,      _grave,     _backslash, _altL,      1,
-    
-                                                                _ctrlL,     _altL,
-                                                    0,          0,          _home,
-                                                    _space,     _enter,     _end,
-
-    // right hand
-    3,          _6,         _7,         _8,         _9,         _0,         _dash,
-    _esc,       _J,         _L,         _U,         _Y,         _semicolon, _backslash,
-                _H,         _N,         _E,         _I,         _O,         _quote,
-    3,          _K,         _M,         _comma,     _period,    _slash,     _shiftR,
-                            1,          _arrowL,    _arrowD,    _arrowU,    _arrowR,
-
-    _altR,      _ctrlR,
-    _pageU,     0,          0,
-    _pageD,     _del,       _bs ),
-
-
-    // LAYOUT L1: function and symbol keys
-    KB_MATRIX_LAYER( 0,
-    // left hand
-    0,          _F1,        _F2,        _F3,        _F4,        _F5,        _F11,
-    0,          _bracketL,  _bracketR,  _bracketL,  _bracketR,  _semicolon, 0,
-    0,          _backslash, _slash,     _9,         _0,         _semicolon,
-    0,          _1,         _2,         _3,         _4,         _5,         0,
-    0,          0,          0,          0,          0,
-
-                                                                0,          0,
-                                                    0,          0,          0,
-                                                    0,          0,          0,
-    // right hand
-    _F12,       _F6,        _F7,        _F8,        _F9,        _F10,       _power,
-    0,          0,          _equal,     _equal,     _dash,      _dash,      0,
-                _arrowL,    _arrowD,    _arrowU,    _arrowR,    0,          0,
-    0,          _6,         _7,         _8,         _9,         _0,         _mute,
-                            0,          0,          0,          0,          0,
-
-    0,          0,
-    0,          0,          0,
-    0,          0,          0 ),
-
-
-    // LAYOUT L2: QWERTY alphanum 
-    KB_MATRIX_LAYER( 0,
-    // left hand
-    0,          _1,         _2,         _3,         _4,         _5,         0,
-    0,          _Q,         _W,         _E,         _R,         _T,         0,
-    0,          _A,         _S,         _D,         _F,         _G,
-    0,          _Z,         _X,         _C,         _V,         _B,         0,
-    0,          0,          0,          0,          0,
-
-                                                                0,          0,
-                                                    0,          0,          0,
-                                                    0,          0,          0,
-    // right hand
-    0,          _6,         _7,         _8,         _9,         _0,         0,
-    0,          _Y,         _U,         _I,         _O,         _P,         0, 
-                _H,         _J,         _K,         _L,         _semicolon, 0,
-    0,          _N,         _M,         _comma,     _period,    _slash,     0,
-                            0,          0,          0,          0,          0,
-                            
-    0,          0,
-    0,          0,          0,
-    0,          0,          0 ),
-
-
-    // LAYOUT L3: numpad
-    KB_MATRIX_LAYER( 0,
-    // left hand
-    0,          0,          0,          0,          0,          0,          0,
-    0,          0,          0,          0,          0,          0,          0,
-    0,          0,          0,          0,          0,          0,
-    0,          0,          0,          0,          0,          0,          0,
-    0,          _insert,    0,          0,          0,
-
-                                                                0,          0,
-                                                    0,          0,          0,
-                                                    0,          0,          0,
-    // right hand
-    3,          0,          3,          _equal_kp,  _div_kp,    _mul_kp,    0,
-    0,          0,          _7_kp,      _8_kp,      _9_kp,      _sub_kp,    0,
-                0,          _4_kp,      _5_kp,      _6_kp,      _add_kp,    0,
-    0,          0,          _1_kp,      _2_kp,      _3_kp,      _enter_kp,  0,
-                            0,          0,          _period,    _enter_kp,  0,
-
-    0,          0,
-    0,          0,          0,
-    0,          0,          _0_kp ),
-
-};
-
-// ----------------------------------------------------------------------------
-// ----------------------------------------------------------------------------
-
 // aliases
 
 // basic
@@ -130,26 +28,11 @@ const uint8_t PROGMEM _kb_layout[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
 #define  ktog    &kbfun_toggle
 #define  ktrans  &kbfun_transparent
 // --- layer push/pop functions
-#define  lpush1   &kbfun_layer_push_1
-#define  lpush2   &kbfun_layer_push_2
-#define  lpush3   &kbfun_layer_push_3
-#define  lpush4   &kbfun_layer_push_4
-#define  lpush5   &kbfun_layer_push_5
-#define  lpush6   &kbfun_layer_push_6
-#define  lpush7   &kbfun_layer_push_7
-#define  lpush8   &kbfun_layer_push_8
-#define  lpush9   &kbfun_layer_push_9
-#define  lpush10  &kbfun_layer_push_10
-#define  lpop1    &kbfun_layer_pop_1
-#define  lpop2    &kbfun_layer_pop_2
-#define  lpop3    &kbfun_layer_pop_3
-#define  lpop4    &kbfun_layer_pop_4
-#define  lpop5    &kbfun_layer_pop_5
-#define  lpop6    &kbfun_layer_pop_6
-#define  lpop7    &kbfun_layer_pop_7
-#define  lpop8    &kbfun_layer_pop_8
-#define  lpop9    &kbfun_layer_pop_9
-#define  lpop10   &kbfun_layer_pop_10
+#define  lpush    &kbfun_layer_push
+#define  lsticky  &kbfun_layer_sticky
+#define  lpop     &kbfun_layer_pop
+#define  ltog     &kbfun_layer_toggle
+#define  lpopall  &kbfun_layer_pop_all
 // ---
 
 // device
@@ -164,220 +47,140 @@ const uint8_t PROGMEM _kb_layout[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
 // ----------------------------------------------------------------------------
 // ----------------------------------------------------------------------------
 
-const void_funptr_t PROGMEM _kb_layout_press[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
-
-    // PRESS L0: COLEMAK
-    KB_MATRIX_LAYER( NULL,
-    // left hand
-    kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     lpush2,
-    kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,
-    kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     
-    s2kcap,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     lpush2,
-    kprrel,     kprrel,     kprrel,     kprrel,     lpush1,
-    
-                                                                kprrel,     kprrel,
-                                                    NULL,       NULL,       kprrel,
-                                                    kprrel,     kprrel,     kprrel,
-    // right hand
-    slpunum,    kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,
-    kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,
-                kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,
-    slpunum,    kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     s2kcap,
-                            lpush1,     kprrel,     kprrel,     kprrel,     kprrel,
-
-    kprrel,     kprrel,
-    kprrel,     NULL,       NULL,
-    kprrel,     kprrel,     kprrel ),
-    
-
-    // PRESS L1: function and symbol keys
-    KB_MATRIX_LAYER( NULL,
-    // left hand
-    NULL,       kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-    ktrans,     sshprre,    sshprre,    kprrel,     kprrel,     sshprre,    ktrans,
-    ktrans,     kprrel,     kprrel,     sshprre,    sshprre,    kprrel,
-    ktrans,     sshprre,    sshprre,    sshprre,    sshprre,    sshprre,    ktrans,
-    ktrans,     ktrans,     ktrans,     ktrans,     ktrans,
-
-                                                                ktrans,     ktrans,
-                                                    ktrans,     ktrans,     ktrans,
-                                                    ktrans,     ktrans,     ktrans,
-    // right hand
-    kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,
-    ktrans,     kprrel,     kprrel,     sshprre,    kprrel,     sshprre,    kprrel,
-                kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,
-    ktrans,     sshprre,    sshprre,    sshprre,    sshprre,    sshprre,    ktrans,
-                            ktrans,     ktrans,     ktrans,     ktrans,     ktrans,
-
-    ktrans,     ktrans,
-    ktrans,     ktrans,     ktrans,
-    ktrans,     ktrans,     ktrans ),
-
-    
-    // PRESS L2: QWERTY 
-    KB_MATRIX_LAYER( NULL,
-    // left hand
-    ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     lpop2,
-    ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-    ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     
-    ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-    ktrans,     ktrans,     ktrans,     ktrans,     ktrans,
-
-                                                                ktrans,     ktrans,     
-                                                    ktrans,     ktrans,     ktrans,
-                                                    ktrans,     ktrans,     ktrans,
-    // right hand
-    ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-    ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-                kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-    ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-                            ktrans,     ktrans,     ktrans,     ktrans,     ktrans,
-
-    ktrans,     ktrans,     
-    ktrans,     ktrans,     ktrans,
-    ktrans,     ktrans,     ktrans ),
-
-
-    // PRESS L3: numpad
-    KB_MATRIX_LAYER( NULL,
-    // left hand
-    ktrans,     ktrans,     ktrans,     ktrans,     ktrans,     ktrans,     ktrans,
-    ktrans,     ktrans,     ktrans,     ktrans,     ktrans,     ktrans,     ktrans,
-    ktrans,     ktrans,     ktrans,     ktrans,     ktrans,     ktrans,     
-    ktrans,     ktrans,     ktrans,     ktrans,     ktrans,     ktrans,     ktrans,
-    ktrans,     kprrel,     ktrans,     ktrans,     ktrans,
-
-                                                                ktrans,     ktrans,     
-                                                    ktrans,     ktrans,     ktrans,
-                                                    ktrans,     ktrans,     ktrans,
-    // right hand
-    slponum,    ktrans,     slponum,    kprrel,     kprrel,     kprrel,     ktrans,
-    ktrans,     ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-                ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-    ktrans,     ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-                            ktrans,     ktrans,     kprrel,     kprrel,     ktrans,
-                
-    ktrans,     ktrans,
-    ktrans,     ktrans,     ktrans,
-    ktrans,     ktrans,     kprrel ),
+// key kinds: the press and release function of each (see
+// "default--matrix-control.h"); keys are `A(kind, keycode)`
+enum kinds {
+	NONE,
+	KPRREL,
+	LPUSH_NONE,
+	S2KCAP,
+	LPUSH_LPOP,
+	SLPUNUM_NONE,
+	SLPUNUM_SLPONUM,
+	KTRANS_KPRREL,
+	KTRANS,
+	SSHPRRE,
+	LPOP_NONE,
+	SLPONUM_NONE,
+};
 
+const kb_layout_kind_t PROGMEM _kb_layout_kinds[] = {
+	[NONE]            = { NULL,    NULL },
+	[KPRREL]          = { kprrel,  kprrel },
+	[LPUSH_NONE]      = { lpush,   NULL },
+	[S2KCAP]          = { s2kcap,  s2kcap },
+	[LPUSH_LPOP]      = { lpush,   lpop },
+	[SLPUNUM_NONE]    = { slpunum, NULL },
+	[SLPUNUM_SLPONUM] = { slpunum, slponum },
+	[KTRANS_KPRREL]   = { ktrans,  kprrel },
+	[KTRANS]          = { ktrans,  ktrans },
+	[SSHPRRE]         = { sshprre, sshprre },
+	[LPOP_NONE]       = { lpop,    NULL },
+	[SLPONUM_NONE]    = { slponum, NULL },
 };
 
+#define  A(kind, keycode)  KB_LAYOUT_ACTION(kind, keycode)
+
 // ----------------------------------------------------------------------------
 // ----------------------------------------------------------------------------
 
-const void_funptr_t PROGMEM _kb_layout_release[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
-
-    // RELEASE L0: COLEMAK
-    KB_MATRIX_LAYER( NULL,
-    // left hand
-    kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     NULL,
-    kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,
-    kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,
-    s2kcap,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     lpop2,
-    kprrel,     kprrel,     kprrel,     kprrel,     lpop1,
-
-                                                                kprrel,     kprrel,
-                                                    NULL,       NULL,       kprrel,
-                                                    kprrel,     kprrel,     kprrel,
-    // right hand
-    NULL,       kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,
-    kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,
-                kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,
-    slponum,    kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     s2kcap,
-                            lpop1,      kprrel,     kprrel,     kprrel,     kprrel,
-
-    kprrel,     kprrel,
-    kprrel,     NULL,       NULL,
-    kprrel,     kprrel,     kprrel ),
-
-
-    // RELEASE L1: function and symbol keys
-    KB_MATRIX_LAYER( NULL,
-    // left hand
-    NULL,       kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,
-    ktrans,     sshprre,    sshprre,    kprrel,     kprrel,     sshprre,    ktrans,
-    ktrans,     kprrel,     kprrel,     sshprre,    sshprre,    kprrel,
-    ktrans,     sshprre,    sshprre,    sshprre,    sshprre,    sshprre,    ktrans,
-    ktrans,     ktrans,     ktrans,     ktrans,     ktrans,
-
-                                                                ktrans,     ktrans,
-                                                    ktrans,     ktrans,     ktrans,
-                                                    ktrans,     ktrans,     ktrans,
-    // right hand
-    kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,
-    ktrans,     kprrel,     kprrel,     sshprre,    kprrel,     sshprre,    kprrel,
-                kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,
-    ktrans,     sshprre,    sshprre,    sshprre,    sshprre,    sshprre,    ktrans,
-                            ktrans,     ktrans,     ktrans,     ktrans,     ktrans,
-                            
-    ktrans,     ktrans,
-    ktrans,     ktrans,     ktrans,
-    ktrans,     ktrans,     ktrans ),
-
-
-    // RELEASE L2: QWERTY
-    KB_MATRIX_LAYER( NULL,
-    // left hand
-    ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     NULL,
-    ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-    ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,
-    ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-    ktrans,     ktrans,     ktrans,     ktrans,     ktrans,
-
-                                                                ktrans,     ktrans,
-                                                    ktrans,     ktrans,     ktrans,
-                                                    ktrans,     ktrans,     ktrans,
-    // right hand
-    ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-    ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-                kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-    ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-                            ktrans,     ktrans,     ktrans,     ktrans,     ktrans,
-
-    ktrans,     ktrans,
-    ktrans,     ktrans,     ktrans,
-    ktrans,     ktrans,     ktrans ),
-
-
-    // RELEASE L3: numpad
-    KB_MATRIX_LAYER( NULL,
-    // left hand
-    ktrans,     ktrans,     ktrans,     ktrans,     ktrans,     ktrans,     ktrans,
-    ktrans,     ktrans,     ktrans,     ktrans,     ktrans,     ktrans,     ktrans,
-    ktrans,     ktrans,     ktrans,     ktrans,     ktrans,     ktrans,
-    ktrans,     ktrans,     ktrans,     ktrans,     ktrans,     ktrans,     ktrans,
-    ktrans,     kprrel,     ktrans,     ktrans,     ktrans,
-
-                                                                ktrans,     ktrans,
-                                                    ktrans,     ktrans,     ktrans,
-                                                    ktrans,     ktrans,     ktrans,
-    // right hand
-    NULL,       ktrans,     NULL,       kprrel,     kprrel,     kprrel,     ktrans,
-    ktrans,     ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-                ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-    lpop3,      ktrans,     kprrel,     kprrel,     kprrel,     kprrel,     ktrans,
-                            ktrans,     ktrans,     kprrel,     kprrel,     ktrans,
-
-    ktrans,     ktrans,
-    ktrans,     ktrans,     ktrans,
-    ktrans,     ktrans,     kprrel ),
-
-
-    // RELEASE L3: nothing (just making sure unused
-    // functions don't get compiled out)
-    KB_MATRIX_LAYER( NULL,
-    // other
-    kprrel, lpush8, lpop8,  NULL,   NULL,   NULL,   NULL,   NULL,
-    ktog,   lpush9, lpop9,  NULL,   NULL,   NULL,   NULL,   NULL,
-    ktrans, lpush10,lpop10, NULL,   NULL,   NULL,   NULL,   NULL,
-    lpush1, lpop1,  NULL,   NULL,   NULL,   NULL,   NULL,   NULL,
-    lpush2, lpop2,  dbtldr, NULL,   NULL,   NULL,   NULL,   NULL,
-    lpush3, lpop3,  NULL,   NULL,   NULL,   NULL,   NULL,   NULL,
-    lpush4, lpop4,  s2kcap, NULL,   NULL,   NULL,   NULL,   NULL,
-    lpush5, lpop5,  slpunum,NULL,   NULL,   NULL,   NULL,   NULL,
-    lpush6, lpop6,  slponum,NULL,   NULL,   NULL,   NULL,   NULL,
-    lpush7, lpop7,  NULL,   NULL,   NULL,   NULL,   NULL,   NULL )
+const uint16_t PROGMEM _kb_layout[KB_LAYERS][KB_ROWS][KB_COLUMNS] = {
+
+	KB_MATRIX_LAYER(  // layer 0
+// unused
+0,
+// left hand
+ A(KPRREL, _equal),     A(KPRREL, _1),         A(KPRREL, _2),    A(KPRREL, _3),      A(KPRREL, _4), A(KPRREL, _5),   A(LPUSH_NONE, 2),
+   A(KPRREL, _tab),     A(KPRREL, _Q),         A(KPRREL, _W),    A(KPRREL, _F),      A(KPRREL, _P), A(KPRREL, _G),    A(KPRREL, _esc),
+ A(KPRREL, _ctrlL),     A(KPRREL, _A),         A(KPRREL, _R),    A(KPRREL, _S),      A(KPRREL, _T), A(KPRREL, _D),
+A(S2KCAP, _shiftL),     A(KPRREL, _Z),         A(KPRREL, _X),    A(KPRREL, _C),      A(KPRREL, _V), A(KPRREL, _B),   A(LPUSH_LPOP, 2),
+  A(KPRREL, _guiL), A(KPRREL, _grave), A(KPRREL, _backslash), A(KPRREL, _altL),   A(LPUSH_LPOP, 1),
+ A(KPRREL, _ctrlL),  A(KPRREL, _altL),
+                 0,                 0,      A(KPRREL, _home),
+ A(KPRREL, _space), A(KPRREL, _enter),       A(KPRREL, _end),
+// right hand
+   A(SLPUNUM_NONE, 3),      A(KPRREL, _6),      A(KPRREL, _7),      A(KPRREL, _8),      A(KPRREL, _9),         A(KPRREL, _0),      A(KPRREL, _dash),
+      A(KPRREL, _esc),      A(KPRREL, _J),      A(KPRREL, _L),      A(KPRREL, _U),      A(KPRREL, _Y), A(KPRREL, _semicolon), A(KPRREL, _backslash),
+        A(KPRREL, _H),      A(KPRREL, _N),      A(KPRREL, _E),      A(KPRREL, _I),      A(KPRREL, _O),     A(KPRREL, _quote),
+A(SLPUNUM_SLPONUM, 3),      A(KPRREL, _K),      A(KPRREL, _M),  A(KPRREL, _comma), A(KPRREL, _period),     A(KPRREL, _slash),    A(S2KCAP, _shiftR),
+     A(LPUSH_LPOP, 1), A(KPRREL, _arrowL), A(KPRREL, _arrowD), A(KPRREL, _arrowU), A(KPRREL, _arrowR),
+     A(KPRREL, _altR),  A(KPRREL, _ctrlR),
+    A(KPRREL, _pageU),                  0,                  0,
+    A(KPRREL, _pageD),    A(KPRREL, _del),     A(KPRREL, _bs) ),
+
+
+	KB_MATRIX_LAYER(  // layer 1
+// unused
+0,
+// left hand
+           0,        A(KPRREL, _F1),        A(KPRREL, _F2),       A(KPRREL, _F3),       A(KPRREL, _F4),         A(KPRREL, _F5), A(KTRANS_KPRREL, _F11),
+A(KTRANS, 0), A(SSHPRRE, _bracketL), A(SSHPRRE, _bracketR), A(KPRREL, _bracketL), A(KPRREL, _bracketR), A(SSHPRRE, _semicolon),           A(KTRANS, 0),
+A(KTRANS, 0), A(KPRREL, _backslash),     A(KPRREL, _slash),       A(SSHPRRE, _9),       A(SSHPRRE, _0),  A(KPRREL, _semicolon),
+A(KTRANS, 0),        A(SSHPRRE, _1),        A(SSHPRRE, _2),       A(SSHPRRE, _3),       A(SSHPRRE, _4),         A(SSHPRRE, _5),           A(KTRANS, 0),
+A(KTRANS, 0),          A(KTRANS, 0),          A(KTRANS, 0),         A(KTRANS, 0),         A(KTRANS, 0),
+A(KTRANS, 0),          A(KTRANS, 0),
+A(KTRANS, 0),          A(KTRANS, 0),          A(KTRANS, 0),
+A(KTRANS, 0),          A(KTRANS, 0),          A(KTRANS, 0),
+// right hand
+   A(KPRREL, _F12),     A(KPRREL, _F6),     A(KPRREL, _F7),     A(KPRREL, _F8),   A(KPRREL, _F9),   A(KPRREL, _F10), A(KPRREL, _power),
+      A(KTRANS, 0),       A(KPRREL, 0),  A(KPRREL, _equal), A(SSHPRRE, _equal), A(KPRREL, _dash), A(SSHPRRE, _dash),      A(KPRREL, 0),
+A(KPRREL, _arrowL), A(KPRREL, _arrowD), A(KPRREL, _arrowU), A(KPRREL, _arrowR),     A(KPRREL, 0),      A(KPRREL, 0),
+      A(KTRANS, 0),     A(SSHPRRE, _6),     A(SSHPRRE, _7),     A(SSHPRRE, _8),   A(SSHPRRE, _9),    A(SSHPRRE, _0),  A(KTRANS, _mute),
+      A(KTRANS, 0),       A(KTRANS, 0),       A(KTRANS, 0),       A(KTRANS, 0),     A(KTRANS, 0),
+      A(KTRANS, 0),       A(KTRANS, 0),
+      A(KTRANS, 0),       A(KTRANS, 0),       A(KTRANS, 0),
+      A(KTRANS, 0),       A(KTRANS, 0),       A(KTRANS, 0) ),
+
+
+	KB_MATRIX_LAYER(  // layer 2
+// unused
+0,
+// left hand
+A(KTRANS, 0), A(KPRREL, _1), A(KPRREL, _2), A(KPRREL, _3), A(KPRREL, _4), A(KPRREL, _5),  A(LPOP_NONE, 2),
+A(KTRANS, 0), A(KPRREL, _Q), A(KPRREL, _W), A(KPRREL, _E), A(KPRREL, _R), A(KPRREL, _T),     A(KTRANS, 0),
+A(KTRANS, 0), A(KPRREL, _A), A(KPRREL, _S), A(KPRREL, _D), A(KPRREL, _F), A(KPRREL, _G),
+A(KTRANS, 0), A(KPRREL, _Z), A(KPRREL, _X), A(KPRREL, _C), A(KPRREL, _V), A(KPRREL, _B),     A(KTRANS, 0),
+A(KTRANS, 0),  A(KTRANS, 0),  A(KTRANS, 0),  A(KTRANS, 0),  A(KTRANS, 0),
+A(KTRANS, 0),  A(KTRANS, 0),
+A(KTRANS, 0),  A(KTRANS, 0),  A(KTRANS, 0),
+A(KTRANS, 0),  A(KTRANS, 0),  A(KTRANS, 0),
+// right hand
+ A(KTRANS, 0), A(KPRREL, _6), A(KPRREL, _7),     A(KPRREL, _8),         A(KPRREL, _9),     A(KPRREL, _0), A(KTRANS, 0),
+ A(KTRANS, 0), A(KPRREL, _Y), A(KPRREL, _U),     A(KPRREL, _I),         A(KPRREL, _O),     A(KPRREL, _P), A(KTRANS, 0),
+A(KPRREL, _H), A(KPRREL, _J), A(KPRREL, _K),     A(KPRREL, _L), A(KPRREL, _semicolon),      A(KTRANS, 0),
+ A(KTRANS, 0), A(KPRREL, _N), A(KPRREL, _M), A(KPRREL, _comma),    A(KPRREL, _period), A(KPRREL, _slash), A(KTRANS, 0),
+ A(KTRANS, 0),  A(KTRANS, 0),  A(KTRANS, 0),      A(KTRANS, 0),          A(KTRANS, 0),
+ A(KTRANS, 0),  A(KTRANS, 0),
+ A(KTRANS, 0),  A(KTRANS, 0),  A(KTRANS, 0),
+ A(KTRANS, 0),  A(KTRANS, 0),  A(KTRANS, 0) ),
+
+
+	KB_MATRIX_LAYER(  // layer 3
+// unused
+0,
+// left hand
+A(KTRANS, 0),       A(KTRANS, 0), A(KTRANS, 0), A(KTRANS, 0), A(KTRANS, 0), A(KTRANS, 0), A(KTRANS, 0),
+A(KTRANS, 0),       A(KTRANS, 0), A(KTRANS, 0), A(KTRANS, 0), A(KTRANS, 0), A(KTRANS, 0), A(KTRANS, 0),
+A(KTRANS, 0),       A(KTRANS, 0), A(KTRANS, 0), A(KTRANS, 0), A(KTRANS, 0), A(KTRANS, 0),
+A(KTRANS, 0),       A(KTRANS, 0), A(KTRANS, 0), A(KTRANS, 0), A(KTRANS, 0), A(KTRANS, 0), A(KTRANS, 0),
+A(KTRANS, 0), A(KPRREL, _insert), A(KTRANS, 0), A(KTRANS, 0), A(KTRANS, 0),
+A(KTRANS, 0),       A(KTRANS, 0),
+A(KTRANS, 0),       A(KTRANS, 0), A(KTRANS, 0),
+A(KTRANS, 0),       A(KTRANS, 0), A(KTRANS, 0),
+// right hand
+A(SLPONUM_NONE, 3),     A(KTRANS, 0), A(SLPONUM_NONE, 3), A(KPRREL, _equal_kp), A(KPRREL, _div_kp),   A(KPRREL, _mul_kp), A(KTRANS, 0),
+      A(KTRANS, 0),     A(KTRANS, 0),   A(KPRREL, _7_kp),     A(KPRREL, _8_kp),   A(KPRREL, _9_kp),   A(KPRREL, _sub_kp), A(KTRANS, 0),
+      A(KTRANS, 0), A(KPRREL, _4_kp),   A(KPRREL, _5_kp),     A(KPRREL, _6_kp), A(KPRREL, _add_kp),         A(KTRANS, 0),
+A(KTRANS, 0),           A(KTRANS, 0),   A(KPRREL, _1_kp),     A(KPRREL, _2_kp),   A(KPRREL, _3_kp), A(KPRREL, _enter_kp), A(KTRANS, 0),
+      A(KTRANS, 0),     A(KTRANS, 0), A(KPRREL, _period), A(KPRREL, _enter_kp),       A(KTRANS, 0),
+      A(KTRANS, 0),     A(KTRANS, 0),
+      A(KTRANS, 0),     A(KTRANS, 0),       A(KTRANS, 0),
+      A(KTRANS, 0),     A(KTRANS, 0),   A(KPRREL, _0_kp) ),
 
 };
 
+// the sparse form of `_kb_layout` (see "default--matrix-control.h")
+#if KB_LAYOUT_SPARSE
+	#include "./colemak-symbol-mod--sparse.h"
+#endif
+
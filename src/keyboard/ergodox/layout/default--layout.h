@@ -14,12 +14,9 @@
 
 	// --------------------------------------------------------------------
 
-	#define kb_led_layer1_on()      _kb_led_1_on()
-	#define kb_led_layer1_off()     _kb_led_1_off()
-	#define kb_led_layer2_on()      _kb_led_2_on()
-	#define kb_led_layer2_off()     _kb_led_2_off()
-    #define kb_led_layer3_on()      _kb_led_3_on()
-    #define kb_led_layer3_off()     _kb_led_3_off()
+	#define KB_LED_LAYER_1          1
+	#define KB_LED_LAYER_2          2
+	#define KB_LED_LAYER_3          3
 	#define kb_led_caps_on()        _kb_led_6_on()
 	#define kb_led_caps_on()        _kb_led_6_off()
 
@@ -94,66 +94,40 @@
 	#ifndef kb_led_kana_off
 	#define kb_led_kana_off()
 	#endif
-    #ifndef kb_led_layer1_on
-    #define kb_led_layer1_on()
-    #endif
-    #ifndef kb_led_layer1_off
-    #define kb_led_layer1_off()
-    #endif
-    #ifndef kb_led_layer2_on
-    #define kb_led_layer2_on()
-    #endif
-    #ifndef kb_led_layer2_off
-    #define kb_led_layer2_off()
-    #endif
-    #ifndef kb_led_layer3_on
-    #define kb_led_layer3_on()
-    #endif
-    #ifndef kb_led_layer3_off
-    #define kb_led_layer3_off()
-    #endif
-    #ifndef kb_led_layer4_on
-    #define kb_led_layer4_on()
-    #endif
-    #ifndef kb_led_layer4_off
-    #define kb_led_layer4_off()
-    #endif
-    #ifndef kb_led_layer5_on
-    #define kb_led_layer5_on()
-    #endif
-    #ifndef kb_led_layer5_off
-    #define kb_led_layer5_off()
-    #endif
-    #ifndef kb_led_layer6_on
-    #define kb_led_layer6_on()
-    #endif
-    #ifndef kb_led_layer6_off
-    #define kb_led_layer6_off()
-    #endif
-    #ifndef kb_led_layer7_on
-    #define kb_led_layer7_on()
-    #endif
-    #ifndef kb_led_layer7_off
-    #define kb_led_layer7_off()
-    #endif
-    #ifndef kb_led_layer8_on
-    #define kb_led_layer8_on()
-    #endif
-    #ifndef kb_led_layer8_off
-    #define kb_led_layer8_off()
-    #endif
-    #ifndef kb_led_layer9_on
-    #define kb_led_layer9_on()
-    #endif
-    #ifndef kb_led_layer9_off
-    #define kb_led_layer9_off()
-    #endif
-    #ifndef kb_led_layer10_on
-    #define kb_led_layer10_on()
-    #endif
-    #ifndef kb_led_layer10_off
-    #define kb_led_layer10_off()
-    #endif
+
+	/*
+	 * layer LEDs
+	 * - `kb_led_layer_on(layer)` and `kb_led_layer_off(layer)` are called by
+	 *   the layer key functions, with the layer being pushed or popped
+	 * - By default, LED 1, 2, and 3 show whichever layers `KB_LED_LAYER_1`,
+	 *   `_2`, and `_3` are set to (if any); layouts may set those, or
+	 *   redefine the macros entirely
+	 */
+
+	#ifndef KB_LED_LAYER_1
+	#define KB_LED_LAYER_1  0xFF  // (no layer)
+	#endif
+	#ifndef KB_LED_LAYER_2
+	#define KB_LED_LAYER_2  0xFF
+	#endif
+	#ifndef KB_LED_LAYER_3
+	#define KB_LED_LAYER_3  0xFF
+	#endif
+
+	#ifndef kb_led_layer_on
+	#define kb_led_layer_on(layer) do {				\
+			if ((layer) == KB_LED_LAYER_1) _kb_led_1_on();	\
+			if ((layer) == KB_LED_LAYER_2) _kb_led_2_on();	\
+			if ((layer) == KB_LED_LAYER_3) _kb_led_3_on();	\
+			} while(0)
+	#endif
+	#ifndef kb_led_layer_off
+	#define kb_led_layer_off(layer) do {				\
+			if ((layer) == KB_LED_LAYER_1) _kb_led_1_off();	\
+			if ((layer) == KB_LED_LAYER_2) _kb_led_2_off();	\
+			if ((layer) == KB_LED_LAYER_3) _kb_led_3_off();	\
+			} while(0)
+	#endif
 
 
 #endif
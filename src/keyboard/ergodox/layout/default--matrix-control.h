@@ -18,9 +18,75 @@
 
 	// --------------------------------------------------------------------
 
+	// the number of layers (layouts may set this in their '.h', before
+	// including this file)
 	#ifndef KB_LAYERS
 		#define KB_LAYERS 10
 	#endif
+	#if KB_LAYERS > 0xFF
+		#error "KB_LAYERS must be less than 256"
+	#endif
+
+	// --------------------------------------------------------------------
+
+	/*
+	 * The layout is one matrix of 16-bit actions per layer: the low byte is
+	 * the keycode (or other argument: a layer number, a media key, ...), and
+	 * the high byte is the key's "kind", an index into a table (one per
+	 * layout) of press and release function pairs.  So each key costs 2
+	 * bytes of Flash per layer, instead of 1 for the keycode and 2 each for
+	 * separate press and release function pointers; and the functions only
+	 * take up space once per kind, rather than once per key.
+	 *
+	 * - Layouts define `_kb_layout_kinds[]` (usually with an `enum` of the
+	 *   kinds they use), and `_kb_layout[][][]`, with `KB_LAYOUT_ACTION()`
+	 *   making each element.  Kind 0 should have no functions (`NULL`,
+	 *   `NULL`), so that unassigned keys (0) do nothing.
+	 * - The key functions still get at everything through the 'get' macros
+	 *   below, which are the only decoder.
+	 */
+
+	typedef struct {
+		void_funptr_t press;
+		void_funptr_t release;
+	} kb_layout_kind_t;
+
+	#define KB_LAYOUT_ACTION(kind, keycode) \
+		( (uint16_t)(kind) << 8 | (uint8_t)(keycode) )
+
+	// --------------------------------------------------------------------
+
+	/*
+	 * Sparse storage (with `KB_LAYOUT_SPARSE`)
+	 *
+	 * Most layers other than the first are mostly transparent (or mostly
+	 * empty), so instead of a full matrix per layer, each layer keeps
+	 * - 'fill': the action of every key without an entry of its own
+	 * - 'defined': for each row, a bitmap of the columns that do have one
+	 * - 'before', 'entries': where in `_kb_layout_entries[]` the entries
+	 *   for each row start
+	 * and a key's entry is found by counting the bits set below it in its
+	 * row's bitmap.
+	 *
+	 * - This costs 22 bytes per layer, plus 2 bytes per entry; so a layer
+	 *   with only a few keys of its own costs a few dozen bytes, instead of
+	 *   168.
+	 * - Layouts are still written as a full `_kb_layout[][][]` matrix;
+	 *   "build-scripts/gen-sparse-layout.py" makes the sparse form from it
+	 *   (at build time), to be included at the end of the layout's '.c'.
+	 *   Since nothing refers to `_kb_layout` then, the linker leaves it out.
+	 */
+
+	#ifndef KB_LAYOUT_SPARSE
+		#define KB_LAYOUT_SPARSE MAKEFILE_SPARSE_LAYOUT
+	#endif
+
+	typedef struct {
+		uint16_t fill;
+		uint16_t entries;
+		uint16_t defined[KB_ROWS];
+		uint8_t  before[KB_ROWS];
+	} kb_layout_sparse_t;
 
 	// --------------------------------------------------------------------
 
@@ -32,7 +98,7 @@
 	 * or any combination of the three, as long as they maintain the same
 	 * interface.
 	 *
-	 * - If the macro is overridden, the matrix declaration must be too,
+	 * - If the macros are overridden, the matrix declarations must be too,
 	 *   and vice versa.
 	 *
 	 * - 'set' functions are optional, and should be defined in the layout
@@ -46,35 +112,73 @@
 	 *   function prototypes, in the layout specific '.h'
 	 */
 
+	#if !defined(kb_layout_get) && KB_LAYOUT_SPARSE
+		extern const kb_layout_sparse_t PROGMEM \
+			       _kb_layout_sparse[KB_LAYERS];
+		extern const uint16_t PROGMEM \
+			       _kb_layout_entries[];
+		extern const kb_layout_kind_t PROGMEM \
+			       _kb_layout_kinds[];
+
+		static inline uint16_t _kb_layout_action_get( uint8_t layer,
+							      uint8_t row,
+							      uint8_t column ) {
+			const kb_layout_sparse_t * l = &_kb_layout_sparse[layer];
+			uint16_t defined = pgm_read_word(&l->defined[row]);
+			uint16_t bit     = (uint16_t)1 << column;
+
+			if (!(defined & bit))
+				return pgm_read_word(&l->fill);
+
+			return pgm_read_word( &_kb_layout_entries[
+					pgm_read_word(&l->entries)
+					+ pgm_read_byte(&l->before[row])
+					+ __builtin_popcount(defined & (bit-1)) ] );
+		}
+
+		#define kb_layout_get(layer,row,column) \
+			( (uint8_t) \
+			  _kb_layout_action_get(layer,row,column) )
+
+		#define _kb_layout_kind_get(layer,row,column) \
+			( (uint8_t) \
+			  ( _kb_layout_action_get(layer,row,column) >> 8 ) )
+	#endif
+
 	#ifndef kb_layout_get
-		extern const uint8_t PROGMEM \
+		extern const uint16_t PROGMEM \
 			       _kb_layout[KB_LAYERS][KB_ROWS][KB_COLUMNS];
+		extern const kb_layout_kind_t PROGMEM \
+			       _kb_layout_kinds[];
 
+		// (the low byte comes first; AVRs are little endian)
 		#define kb_layout_get(layer,row,column) \
 			( (uint8_t) \
-			  pgm_read_byte(&( \
-				_kb_layout[layer][row][column] )) )
+			  pgm_read_byte( (const uint8_t *)&( \
+				_kb_layout[layer][row][column] ) ) )
+
+		#define _kb_layout_kind_get(layer,row,column) \
+			( (uint8_t) \
+			  pgm_read_byte( (const uint8_t *)&( \
+				_kb_layout[layer][row][column] ) + 1 ) )
 	#endif
 
 	#ifndef kb_layout_press_get
-		extern const void_funptr_t PROGMEM \
-			_kb_layout_press[KB_LAYERS][KB_ROWS][KB_COLUMNS];
-
 		#define kb_layout_press_get(layer,row,column) \
 			( (void_funptr_t) \
 			  pgm_read_word(&( \
-				_kb_layout_press[layer][row][column] )) )
+				_kb_layout_kinds[ \
+					_kb_layout_kind_get(layer,row,column) \
+				].press )) )
 	#endif
 
 	#ifndef kb_layout_release_get
-		extern const void_funptr_t PROGMEM \
-			_kb_layout_release[KB_LAYERS][KB_ROWS][KB_COLUMNS];
-
 		#define kb_layout_release_get(layer,row,column) \
 			( (void_funptr_t) \
 			  pgm_read_word(&( \
-				_kb_layout_release[layer][row][column] )) )
-
+				_kb_layout_kinds[ \
+					_kb_layout_kind_get(layer,row,column) \
+				].release )) )
 	#endif
 
 #endif
@@ -15,6 +15,12 @@
 	#define KB_ROWS      6  // must match real life
 	#define KB_COLUMNS  14  // must match real life
 
+	// the matrix is passed around as one `uint16_t` bitmap per row, with
+	// bit `n` of each row set if the key in column `n` is pressed
+	#if KB_COLUMNS > 16
+		#error "Expecting at most 16 columns (one bit each, per row)"
+	#endif
+
 	// --------------------------------------------------------------------
 
 	/* mapping from spatial position to matrix position
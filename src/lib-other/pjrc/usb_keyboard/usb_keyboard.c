@@ -24,8 +24,11 @@
 // Version 1.0: Initial Release
 // Version 1.1: Add support for Teensy 2.0
 
+#include <string.h>
 #define USB_SERIAL_PRIVATE_INCLUDE
 #include "usb_keyboard.h"
+#include "../../../lib/timer.h"
+#include "../../../lib/mousekeys.h"
 
 /**************************************************************************
  *
@@ -53,6 +56,17 @@
 // operating systems.
 #define SUPPORT_ENDPOINT_HALT
 
+// How often the host should poll each (interrupt IN) endpoint, in ms.  Full
+// speed devices may ask for anything from 1 to 255.
+#ifdef MAKEFILE_USB_POLL_INTERVAL
+#define POLL_INTERVAL		MAKEFILE_USB_POLL_INTERVAL
+#else
+#define POLL_INTERVAL		10
+#endif
+#if POLL_INTERVAL < 1 || POLL_INTERVAL > 255
+#error "USB_POLL_INTERVAL must be between 1 and 255 (ms)"
+#endif
+
 /* report id */
 #define REPORT_ID_SYSTEM    2
 #define REPORT_ID_CONSUMER  3
@@ -64,6 +78,11 @@
  **************************************************************************/
 #define ENDPOINT0_SIZE		32
 
+// The report (keyboard, extra, NKRO, and mouse) IN endpoints are double
+// buffered, so that two reports can be waiting for the host at once (see
+// "Report Queues").  The raw HID endpoints aren't: telemetry only ever has
+// one reply outstanding.
+
 #define KEYBOARD_INTERFACE	0
 #define KEYBOARD_ENDPOINT	1
 #define KEYBOARD_SIZE		8
@@ -71,14 +90,41 @@
 
 #define EXTRA_INTERFACE		1
 #define EXTRA_ENDPOINT		2
-#define EXTRA_SIZE		8
+#define EXTRA_SIZE		16
 #define EXTRA_BUFFER		EP_DOUBLE_BUFFER
 
-
+// n-key rollover keyboard: 1 modifier byte, then a bitmap of keycodes
+#define NKRO_INTERFACE		2
+#define NKRO_ENDPOINT		3
+#define NKRO_SIZE		32
+#define NKRO_BUFFER		EP_DOUBLE_BUFFER
+#define NKRO_REPORT_SIZE	(1 + KEYBOARD_NKRO_KEYS/8)
+
+// mouse: 1 byte of buttons, then X, Y, and wheel
+#define MOUSE_INTERFACE		3
+#define MOUSE_ENDPOINT		4
+#define MOUSE_SIZE		8
+#define MOUSE_BUFFER		EP_DOUBLE_BUFFER
+
+// raw HID: vendor defined, RAWHID_SIZE byte reports each way (for telemetry
+// and runtime settings; see "src/telemetry.c")
+#define RAWHID_INTERFACE	4
+#define RAWHID_TX_ENDPOINT	5
+#define RAWHID_RX_ENDPOINT	6
+#define RAWHID_TX_BUFFER	EP_SINGLE_BUFFER
+#define RAWHID_RX_BUFFER	EP_SINGLE_BUFFER
+#define RAWHID_USAGE_PAGE	0xFFAB
+#define RAWHID_USAGE		0x0200
+
+
+// one entry per endpoint, 1..MAX_ENDPOINT
 static const uint8_t PROGMEM endpoint_config_table[] = {
 	1, EP_TYPE_INTERRUPT_IN,  EP_SIZE(KEYBOARD_SIZE) | KEYBOARD_BUFFER,
 	1, EP_TYPE_INTERRUPT_IN,  EP_SIZE(EXTRA_SIZE)    | EXTRA_BUFFER,    // 4
-	0
+	1, EP_TYPE_INTERRUPT_IN,  EP_SIZE(NKRO_SIZE)     | NKRO_BUFFER,
+	1, EP_TYPE_INTERRUPT_IN,  EP_SIZE(MOUSE_SIZE)    | MOUSE_BUFFER,
+	1, EP_TYPE_INTERRUPT_IN,  EP_SIZE(RAWHID_SIZE)   | RAWHID_TX_BUFFER,
+	1, EP_TYPE_INTERRUPT_OUT, EP_SIZE(RAWHID_SIZE)   | RAWHID_RX_BUFFER,
 };
 
 
@@ -148,20 +194,105 @@ static const uint8_t PROGMEM keyboard_hid_report_desc[] = {
         0xc0                 // End Collection
 };
 
+// N-key rollover keyboard: every key (below KEYBOARD_NKRO_KEYS) gets a bit,
+// so any number can be down at once
+static const uint8_t PROGMEM nkro_hid_report_desc[] = {
+        0x05, 0x01,          // Usage Page (Generic Desktop),
+        0x09, 0x06,          // Usage (Keyboard),
+        0xA1, 0x01,          // Collection (Application),
+        0x75, 0x01,          //   Report Size (1),
+        0x95, 0x08,          //   Report Count (8),
+        0x05, 0x07,          //   Usage Page (Key Codes),
+        0x19, 0xE0,          //   Usage Minimum (224),
+        0x29, 0xE7,          //   Usage Maximum (231),
+        0x15, 0x00,          //   Logical Minimum (0),
+        0x25, 0x01,          //   Logical Maximum (1),
+        0x81, 0x02,          //   Input (Data, Variable, Absolute), ;Modifier byte
+        0x95, KEYBOARD_NKRO_KEYS, //   Report Count (224),
+        0x75, 0x01,          //   Report Size (1),
+        0x19, 0x00,          //   Usage Minimum (0),
+        0x29, KEYBOARD_NKRO_KEYS-1, //   Usage Maximum (223),
+        0x81, 0x02,          //   Input (Data, Variable, Absolute), ;Key bitmap
+        0xc0                 // End Collection
+};
+
+// Mouse: 5 buttons, and relative X, Y, and wheel motion (-127..127)
+static const uint8_t PROGMEM mouse_hid_report_desc[] = {
+        0x05, 0x01,          // Usage Page (Generic Desktop),
+        0x09, 0x02,          // Usage (Mouse),
+        0xA1, 0x01,          // Collection (Application),
+        0x09, 0x01,          //   Usage (Pointer),
+        0xA1, 0x00,          //   Collection (Physical),
+        0x05, 0x09,          //     Usage Page (Buttons),
+        0x19, 0x01,          //     Usage Minimum (1),
+        0x29, 0x05,          //     Usage Maximum (5),
+        0x15, 0x00,          //     Logical Minimum (0),
+        0x25, 0x01,          //     Logical Maximum (1),
+        0x95, 0x05,          //     Report Count (5),
+        0x75, 0x01,          //     Report Size (1),
+        0x81, 0x02,          //     Input (Data, Variable, Absolute), ;Buttons
+        0x95, 0x01,          //     Report Count (1),
+        0x75, 0x03,          //     Report Size (3),
+        0x81, 0x03,          //     Input (Constant),                 ;Padding
+        0x05, 0x01,          //     Usage Page (Generic Desktop),
+        0x09, 0x30,          //     Usage (X),
+        0x09, 0x31,          //     Usage (Y),
+        0x09, 0x38,          //     Usage (Wheel),
+        0x15, 0x81,          //     Logical Minimum (-127),
+        0x25, 0x7F,          //     Logical Maximum (127),
+        0x75, 0x08,          //     Report Size (8),
+        0x95, 0x03,          //     Report Count (3),
+        0x81, 0x06,          //     Input (Data, Variable, Relative),
+        0xc0,                //   End Collection
+        0xc0                 // End Collection
+};
+
+// Raw HID: opaque bytes, one report each way
+static const uint8_t PROGMEM rawhid_hid_report_desc[] = {
+        0x06, LSB(RAWHID_USAGE_PAGE), MSB(RAWHID_USAGE_PAGE), // Usage Page (Vendor),
+        0x0A, LSB(RAWHID_USAGE), MSB(RAWHID_USAGE),           // Usage (Vendor),
+        0xA1, 0x01,          // Collection (Application),
+        0x75, 0x08,          //   Report Size (8),
+        0x15, 0x00,          //   Logical Minimum (0),
+        0x26, 0xFF, 0x00,    //   Logical Maximum (255),
+        0x95, RAWHID_SIZE,   //   Report Count (RAWHID_SIZE),
+        0x09, 0x01,          //   Usage (Vendor),
+        0x81, 0x02,          //   Input (Data, Variable, Absolute),
+        0x95, RAWHID_SIZE,   //   Report Count (RAWHID_SIZE),
+        0x09, 0x02,          //   Usage (Vendor),
+        0x91, 0x02,          //   Output (Data, Variable, Absolute),
+        0xc0                 // End Collection
+};
+
 // audio controls & system controls
 // http://www.microsoft.com/whdc/archive/w2kbd.mspx
+// - each report is an array of the usages currently pressed: up to
+//   CONSUMER_KEYS consumer usages at once, and 1 system control usage
 static const uint8_t PROGMEM extra_hid_report_desc[] = {
+    /* system control */
+    0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
+    0x09, 0x80,                    // USAGE (System Control)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, REPORT_ID_SYSTEM,        //   REPORT_ID (2)
+    0x15, 0x01,                    //   LOGICAL_MINIMUM (0x1)
+    0x26, 0xb7, 0x00,              //   LOGICAL_MAXIMUM (0xb7)
+    0x19, 0x01,                    //   USAGE_MINIMUM (0x1)
+    0x29, 0xb7,                    //   USAGE_MAXIMUM (0xb7)
+    0x75, 0x10,                    //   REPORT_SIZE (16)
+    0x95, 0x01,                    //   REPORT_COUNT (1)
+    0x81, 0x00,                    //   INPUT (Data,Array,Abs)
+    0xc0,                          // END_COLLECTION
     /* consumer */
     0x05, 0x0c,                    // USAGE_PAGE (Consumer Devices)
     0x09, 0x01,                    // USAGE (Consumer Control)
     0xa1, 0x01,                    // COLLECTION (Application)
     0x85, REPORT_ID_CONSUMER,      //   REPORT_ID (3)
     0x15, 0x01,                    //   LOGICAL_MINIMUM (0x1)
-    0x26, 0x9c, 0x02,              //   LOGICAL_MAXIMUM (0x29c)
+    0x26, 0xff, 0x03,              //   LOGICAL_MAXIMUM (0x3ff)
     0x19, 0x01,                    //   USAGE_MINIMUM (0x1)
-    0x2a, 0x9c, 0x02,              //   USAGE_MAXIMUM (0x29c)
+    0x2a, 0xff, 0x03,              //   USAGE_MAXIMUM (0x3ff)
     0x75, 0x10,                    //   REPORT_SIZE (16)
-    0x95, 0x01,                    //   REPORT_COUNT (1)
+    0x95, CONSUMER_KEYS,           //   REPORT_COUNT (CONSUMER_KEYS)
     0x81, 0x00,                    //   INPUT (Data,Array,Abs)
     0xc0,                          // END_COLLECTION
 };
@@ -172,8 +303,18 @@ static const uint8_t PROGMEM extra_hid_report_desc[] = {
 #   define EXTRA_HID_DESC_NUM           (KEYBOARD_HID_DESC_NUM + 1)
 #   define EXTRA_HID_DESC_OFFSET        (9+(9+9+7)*EXTRA_HID_DESC_NUM+9)
 
-#define NUM_INTERFACES                  (EXTRA_HID_DESC_NUM + 1)
-#define CONFIG1_DESC_SIZE               (9+(9+9+7)*NUM_INTERFACES)
+#   define NKRO_HID_DESC_NUM            (EXTRA_HID_DESC_NUM + 1)
+#   define NKRO_HID_DESC_OFFSET         (9+(9+9+7)*NKRO_HID_DESC_NUM+9)
+
+#   define MOUSE_HID_DESC_NUM           (NKRO_HID_DESC_NUM + 1)
+#   define MOUSE_HID_DESC_OFFSET        (9+(9+9+7)*MOUSE_HID_DESC_NUM+9)
+
+#   define RAWHID_HID_DESC_NUM          (MOUSE_HID_DESC_NUM + 1)
+#   define RAWHID_HID_DESC_OFFSET       (9+(9+9+7)*RAWHID_HID_DESC_NUM+9)
+
+// (the raw HID interface, last, has an extra endpoint)
+#define NUM_INTERFACES                  (RAWHID_HID_DESC_NUM + 1)
+#define CONFIG1_DESC_SIZE               (9+(9+9+7)*NUM_INTERFACES+7)
 //#define KEYBOARD_HID_DESC_OFFSET (9+9)
 static const uint8_t PROGMEM config1_descriptor[CONFIG1_DESC_SIZE] = {
 	// configuration descriptor, USB spec 9.6.3, page 264-266, Table 9-10
@@ -184,7 +325,8 @@ static const uint8_t PROGMEM config1_descriptor[CONFIG1_DESC_SIZE] = {
 	NUM_INTERFACES,					// bNumInterfaces
 	1,					// bConfigurationValue
 	0,					// iConfiguration
-	0xC0,					// bmAttributes
+	0xA0,					// bmAttributes (bus powered, remote
+						//   wakeup)
 	50,					// bMaxPower
 	// interface descriptor, USB spec 9.6.5, page 267-269, Table 9-12
 	9,					// bLength
@@ -212,7 +354,7 @@ static const uint8_t PROGMEM config1_descriptor[CONFIG1_DESC_SIZE] = {
 	KEYBOARD_ENDPOINT | 0x80,			// bEndpointAddress
 	0x03,					// bmAttributes (0x03=intr)
 	KEYBOARD_SIZE, 0,				// wMaxPacketSize
-	10,					// bInterval
+	POLL_INTERVAL,				// bInterval
 
 	// interface descriptor, USB spec 9.6.5, page 267-269, Table 9-12
 	9,					// bLength
@@ -239,7 +381,95 @@ static const uint8_t PROGMEM config1_descriptor[CONFIG1_DESC_SIZE] = {
 	EXTRA_ENDPOINT | 0x80,			// bEndpointAddress
 	0x03,					// bmAttributes (0x03=intr)
 	EXTRA_SIZE, 0,				// wMaxPacketSize
-	10,					// bInterval
+	POLL_INTERVAL,				// bInterval
+
+	// interface descriptor, USB spec 9.6.5, page 267-269, Table 9-12
+	9,					// bLength
+	4,					// bDescriptorType
+	NKRO_INTERFACE,				// bInterfaceNumber
+	0,					// bAlternateSetting
+	1,					// bNumEndpoints
+	0x03,					// bInterfaceClass (0x03 = HID)
+	0x00,					// bInterfaceSubClass
+	0x00,					// bInterfaceProtocol
+	0,					// iInterface
+	// HID descriptor, HID 1.11 spec, section 6.2.1
+	9,					// bLength
+	0x21,					// bDescriptorType
+	0x11, 0x01,				// bcdHID
+	0,					// bCountryCode
+	1,					// bNumDescriptors
+	0x22,					// bDescriptorType
+	sizeof(nkro_hid_report_desc),		// wDescriptorLength
+	0,
+	// endpoint descriptor, USB spec 9.6.6, page 269-271, Table 9-13
+	7,					// bLength
+	5,					// bDescriptorType
+	NKRO_ENDPOINT | 0x80,			// bEndpointAddress
+	0x03,					// bmAttributes (0x03=intr)
+	NKRO_SIZE, 0,				// wMaxPacketSize
+	POLL_INTERVAL,				// bInterval
+
+	// interface descriptor, USB spec 9.6.5, page 267-269, Table 9-12
+	9,					// bLength
+	4,					// bDescriptorType
+	MOUSE_INTERFACE,			// bInterfaceNumber
+	0,					// bAlternateSetting
+	1,					// bNumEndpoints
+	0x03,					// bInterfaceClass (0x03 = HID)
+	0x00,					// bInterfaceSubClass
+	0x00,					// bInterfaceProtocol
+	0,					// iInterface
+	// HID descriptor, HID 1.11 spec, section 6.2.1
+	9,					// bLength
+	0x21,					// bDescriptorType
+	0x11, 0x01,				// bcdHID
+	0,					// bCountryCode
+	1,					// bNumDescriptors
+	0x22,					// bDescriptorType
+	sizeof(mouse_hid_report_desc),		// wDescriptorLength
+	0,
+	// endpoint descriptor, USB spec 9.6.6, page 269-271, Table 9-13
+	7,					// bLength
+	5,					// bDescriptorType
+	MOUSE_ENDPOINT | 0x80,			// bEndpointAddress
+	0x03,					// bmAttributes (0x03=intr)
+	MOUSE_SIZE, 0,				// wMaxPacketSize
+	POLL_INTERVAL,				// bInterval
+
+	// interface descriptor, USB spec 9.6.5, page 267-269, Table 9-12
+	9,					// bLength
+	4,					// bDescriptorType
+	RAWHID_INTERFACE,			// bInterfaceNumber
+	0,					// bAlternateSetting
+	2,					// bNumEndpoints
+	0x03,					// bInterfaceClass (0x03 = HID)
+	0x00,					// bInterfaceSubClass
+	0x00,					// bInterfaceProtocol
+	0,					// iInterface
+	// HID descriptor, HID 1.11 spec, section 6.2.1
+	9,					// bLength
+	0x21,					// bDescriptorType
+	0x11, 0x01,				// bcdHID
+	0,					// bCountryCode
+	1,					// bNumDescriptors
+	0x22,					// bDescriptorType
+	sizeof(rawhid_hid_report_desc),		// wDescriptorLength
+	0,
+	// endpoint descriptor, USB spec 9.6.6, page 269-271, Table 9-13
+	7,					// bLength
+	5,					// bDescriptorType
+	RAWHID_TX_ENDPOINT | 0x80,		// bEndpointAddress
+	0x03,					// bmAttributes (0x03=intr)
+	RAWHID_SIZE, 0,				// wMaxPacketSize
+	POLL_INTERVAL,				// bInterval
+	// endpoint descriptor, USB spec 9.6.6, page 269-271, Table 9-13
+	7,					// bLength
+	5,					// bDescriptorType
+	RAWHID_RX_ENDPOINT,			// bEndpointAddress
+	0x03,					// bmAttributes (0x03=intr)
+	RAWHID_SIZE, 0,				// wMaxPacketSize
+	POLL_INTERVAL,				// bInterval
 };
 
 // If you're desperate for a little extra code memory, these strings
@@ -284,6 +514,15 @@ static struct descriptor_list_struct {
 	    // Extra HID Descriptor
 	{0x2100, EXTRA_INTERFACE, config1_descriptor+EXTRA_HID_DESC_OFFSET, 9},
 	{0x2200, EXTRA_INTERFACE, extra_hid_report_desc, sizeof(extra_hid_report_desc)},
+	    // NKRO HID Descriptor
+	{0x2100, NKRO_INTERFACE, config1_descriptor+NKRO_HID_DESC_OFFSET, 9},
+	{0x2200, NKRO_INTERFACE, nkro_hid_report_desc, sizeof(nkro_hid_report_desc)},
+	    // Mouse HID Descriptor
+	{0x2100, MOUSE_INTERFACE, config1_descriptor+MOUSE_HID_DESC_OFFSET, 9},
+	{0x2200, MOUSE_INTERFACE, mouse_hid_report_desc, sizeof(mouse_hid_report_desc)},
+	    // Raw HID Descriptor
+	{0x2100, RAWHID_INTERFACE, config1_descriptor+RAWHID_HID_DESC_OFFSET, 9},
+	{0x2200, RAWHID_INTERFACE, rawhid_hid_report_desc, sizeof(rawhid_hid_report_desc)},
         // STRING descriptors
 	{0x0300, 0x0000, (const uint8_t *)&string0, 4},
 	{0x0301, 0x0409, (const uint8_t *)&string1, sizeof(STR_MANUFACTURER)},
@@ -301,6 +540,15 @@ static struct descriptor_list_struct {
 // zero when we are not configured, non-zero when enumerated
 static volatile uint8_t usb_configuration=0;
 
+// whether the bus is suspended (with the USB clock frozen, and the PLL off),
+// and whether the host has allowed us to wake it up
+static volatile uint8_t usb_suspend_state=0;
+static volatile uint8_t usb_remote_wakeup_enabled=0;
+
+// how many frames go by between calls to `timer_sync_event()`, so that scan
+// ticks longer than a frame lock to every Nth one (set by `main()`)
+volatile uint8_t usb_frames_per_sync=1;
+
 // which modifier keys are currently pressed
 // 1=left ctrl,    2=left shift,   4=left alt,    8=left gui
 // 16=right ctrl, 32=right shift, 64=right alt, 128=right gui
@@ -309,9 +557,16 @@ uint8_t keyboard_modifier_keys=0;
 // which keys are currently pressed, up to 6 keys may be down at once
 uint8_t keyboard_keys[6]={0,0,0,0,0,0};
 
-// protocol setting from the host.  We use exactly the same report
-// either way, so this variable only stores the setting since we
-// are required to be able to report which setting is in use.
+// which keys are currently pressed, one bit per keycode (for the NKRO
+// interface)
+uint8_t keyboard_nkro_keys[KEYBOARD_NKRO_KEYS/8];
+
+// protocol setting from the host.  0 = boot protocol: BIOS and the like,
+// which only understand the boot interface; so everything is sent there.
+// 1 = report protocol (the default): the host understands the report
+// descriptors, so keys are sent on the NKRO interface, and the boot
+// interface just sends empty reports.  A bus reset sets it back to 1 (HID
+// 1.11, section 7.2.6).
 static uint8_t keyboard_protocol=1;
 
 // the idle configuration, how often we send the report to the
@@ -324,8 +579,270 @@ static uint8_t keyboard_idle_count=0;
 // 1=num lock, 2=caps lock, 4=scroll lock, 8=compose, 16=kana
 volatile uint8_t keyboard_leds=0;
 
-// which consumer key is currently pressed
-uint16_t consumer_key;
+// which consumer keys (0 = an empty slot), and which system control key,
+// are currently pressed
+uint16_t consumer_keys[CONSUMER_KEYS];
+uint16_t system_key;
+
+// whether the keyboard (modifier_keys, keys, nkro_keys), consumer
+// (consumer_keys), or system control (system_key) state has changed since it
+// was last sent; set by whoever changes it, and by us when the host needs it
+// sent again (after a reset, or a protocol change)
+volatile uint8_t keyboard_report_dirty=1;
+volatile uint8_t consumer_report_dirty=1;
+volatile uint8_t system_report_dirty=1;
+
+// mouse buttons currently pressed (bit 0 = button 1), and motion not yet sent
+// (added to by `mousekeys_frame()`)
+volatile uint8_t mouse_buttons;
+int16_t mouse_x, mouse_y, mouse_wheel;
+
+// the buttons last sent
+static uint8_t mouse_buttons_sent;
+
+
+// build the boot report (empty, if the NKRO interface is in use)
+static void usb_keyboard_build_boot(uint8_t *buf)
+{
+	uint8_t i, nkro = keyboard_protocol;
+
+	buf[0] = nkro ? 0 : keyboard_modifier_keys;
+	buf[1] = 0;
+	for (i=0; i<6; i++) {
+		buf[2+i] = nkro ? 0 : keyboard_keys[i];
+	}
+}
+
+// build the NKRO report
+static void usb_keyboard_build_nkro(uint8_t *buf)
+{
+	uint8_t i;
+
+	buf[0] = keyboard_modifier_keys;
+	for (i=0; i<KEYBOARD_NKRO_KEYS/8; i++) {
+		buf[1+i] = keyboard_nkro_keys[i];
+	}
+}
+
+// build an extra report (for either report ID)
+static void usb_extra_build(uint8_t *buf, uint8_t report_id)
+{
+	uint8_t i, count;
+	const uint16_t *usages;
+
+	if (report_id == REPORT_ID_CONSUMER) {
+		usages = consumer_keys;
+		count = CONSUMER_KEYS;
+	} else {
+		usages = &system_key;
+		count = 1;
+	}
+	*buf++ = report_id;
+	for (i=0; i<count; i++) {
+		*buf++ = LSB(usages[i]);
+		*buf++ = MSB(usages[i]);
+	}
+}
+
+// write a report to the current endpoint
+static void usb_write(const uint8_t *buf, uint8_t length)
+{
+	while (length--) {
+		UEDATX = *buf++;
+	}
+}
+
+// take (up to) one report's worth of motion from 'd'
+static int8_t usb_mouse_take(int16_t *d)
+{
+	int8_t r = (*d > 127) ? 127 : (*d < -127) ? -127 : *d;
+	*d -= r;
+	return r;
+}
+
+// send a mouse report, if anything's changed and the endpoint has room; the
+// motion that doesn't fit waits for the next one
+// - must be called with interrupts disabled
+static void usb_mouse_send(void)
+{
+	uint8_t buttons = mouse_buttons;
+
+	if (buttons == mouse_buttons_sent && !mouse_x && !mouse_y && !mouse_wheel)
+		return;
+	UENUM = MOUSE_ENDPOINT;
+	if (!(UEINTX & (1<<RWAL))) return;
+	mouse_buttons_sent = buttons;
+	UEDATX = buttons;
+	UEDATX = usb_mouse_take(&mouse_x);
+	UEDATX = usb_mouse_take(&mouse_y);
+	UEDATX = usb_mouse_take(&mouse_wheel);
+	UEINTX = 0x3A;
+	usb_reports_sent++;
+}
+
+
+/**************************************************************************
+ *
+ *  Report Queues
+ *
+ **************************************************************************/
+
+// Reports aren't written to the endpoints directly; they're queued, and
+// the queues are drained (oldest first) whenever an endpoint has a free
+// bank: right away, if possible, and then from the start of frame
+// interrupt.  So sending never blocks, no matter what the host is doing,
+// and reports go out in the order they were sent.
+//
+// - A report that's the same as the last one queued (for that queue) is
+//   dropped, since it wouldn't change anything on the host.
+// - Nothing queued is ever overwritten.  If a queue is full (the host has
+//   stopped reading; or, suspend) the report is refused, and its dirty
+//   flag is left set, so it's sent again later.  `main()` doesn't handle
+//   any more key events until there's room (see `usb_report_queue_room()`),
+//   so no report (e.g. half of a quick press/release pair) is lost.
+
+#define REPORT_QUEUE_SIZE	8	// must be a power of 2
+#define REPORT_QUEUE_MASK	(REPORT_QUEUE_SIZE-1)
+
+// extra reports are a report ID, then an array of 16-bit usages
+#define SYSTEM_REPORT_SIZE	(1 + 2)
+#define CONSUMER_REPORT_SIZE	(1 + 2*CONSUMER_KEYS)
+#define EXTRA_REPORT_SIZE	CONSUMER_REPORT_SIZE  // the larger
+#define EXTRA_REPORT_LENGTH(id) \
+	((id) == REPORT_ID_CONSUMER ? CONSUMER_REPORT_SIZE : SYSTEM_REPORT_SIZE)
+
+// keyboard reports: boot (KEYBOARD_ENDPOINT) or NKRO (NKRO_ENDPOINT)
+struct keyboard_report {
+	uint8_t endpoint;
+	uint8_t data[NKRO_REPORT_SIZE];
+};
+static struct keyboard_report keyboard_queue[REPORT_QUEUE_SIZE];
+static struct keyboard_report keyboard_last;  // the last one queued
+static uint8_t keyboard_queue_head, keyboard_queue_tail;  // free running
+
+// extra (system and consumer control) reports; the last one queued is kept
+// for each report ID, so each is only sent when it changes
+static uint8_t extra_queue[REPORT_QUEUE_SIZE][EXTRA_REPORT_SIZE];
+static uint8_t extra_last[2][EXTRA_REPORT_SIZE];  // [report ID - SYSTEM]
+static uint8_t extra_queue_head, extra_queue_tail;
+
+// the number of times a report was refused because a queue was full
+// (counted once each time a queue fills up, not once per retry; saturating)
+uint16_t usb_report_overflows;
+static uint8_t keyboard_queue_full, extra_queue_full;  // counted already
+
+// reports handed to the hardware, on all endpoints: a running count, and the
+// count for the last second (1000 frames).  In steady state, a bank is only
+// freed when the host reads it, so with `USB_RATE_TEST` on (and the keyboard
+// endpoint always full) the rate is the rate at which the host is actually
+// polling.
+uint16_t usb_reports_sent;
+uint16_t usb_report_rate;
+
+// must be called with interrupts disabled
+static void usb_report_queue_drain(void)
+{
+	struct keyboard_report *report;
+
+	// (the endpoints can't be touched with the clock frozen; everything
+	// waits for the resume)
+	if (usb_suspend_state) return;
+
+	while (keyboard_queue_head != keyboard_queue_tail) {
+		report = &keyboard_queue[keyboard_queue_head & REPORT_QUEUE_MASK];
+		UENUM = report->endpoint;
+		if (!(UEINTX & (1<<RWAL))) break;
+		if (report->endpoint == NKRO_ENDPOINT) {
+			usb_write(report->data, NKRO_REPORT_SIZE);
+		} else {
+			usb_write(report->data, KEYBOARD_SIZE);
+			keyboard_idle_count = 0;
+		}
+		UEINTX = 0x3A;
+		usb_reports_sent++;
+		keyboard_queue_head++;
+	}
+
+	while (extra_queue_head != extra_queue_tail) {
+		uint8_t *data = extra_queue[extra_queue_head & REPORT_QUEUE_MASK];
+		UENUM = EXTRA_ENDPOINT;
+		if (!(UEINTX & (1<<RWAL))) break;
+		usb_write(data, EXTRA_REPORT_LENGTH(data[0]));
+		UEINTX = 0x3A;
+		usb_reports_sent++;
+		extra_queue_head++;
+	}
+}
+
+// must be called with interrupts disabled
+static void usb_report_queue_clear(void)
+{
+	keyboard_queue_head = keyboard_queue_tail = 0;
+	extra_queue_head = extra_queue_tail = 0;
+	keyboard_last.endpoint = 0;  // so the next report is always queued
+	extra_last[0][0] = extra_last[1][0] = 0;
+	keyboard_queue_full = extra_queue_full = 0;
+}
+
+static void usb_report_overflow(uint8_t *counted)
+{
+	if (!*counted && usb_report_overflows < 0xFFFF) usb_report_overflows++;
+	*counted = 1;
+}
+
+// queue a keyboard report (unless it's the same as the last one)
+// - returns -1 if the queue was full; the caller should try again later
+static int8_t usb_keyboard_queue(const struct keyboard_report *report)
+{
+	uint8_t intr_state, i;
+
+	intr_state = SREG;
+	cli();
+	if ( report->endpoint == keyboard_last.endpoint &&
+	     !memcmp(report->data, keyboard_last.data, NKRO_REPORT_SIZE) ) {
+		SREG = intr_state;
+		return 0;
+	}
+	if ((uint8_t)(keyboard_queue_tail - keyboard_queue_head) == REPORT_QUEUE_SIZE) {
+		usb_report_overflow(&keyboard_queue_full);
+		SREG = intr_state;
+		return -1;
+	}
+	keyboard_queue_full = 0;
+	keyboard_last = *report;
+	i = keyboard_queue_tail++ & REPORT_QUEUE_MASK;
+	keyboard_queue[i] = *report;
+	usb_report_queue_drain();
+	SREG = intr_state;
+	return 0;
+}
+
+// queue an extra report (unless it's the same as the last one with its ID)
+// - returns -1 if the queue was full; the caller should try again later
+static int8_t usb_extra_queue(const uint8_t *data)
+{
+	uint8_t intr_state, i, length = EXTRA_REPORT_LENGTH(data[0]);
+	uint8_t *last = extra_last[data[0] - REPORT_ID_SYSTEM];
+
+	intr_state = SREG;
+	cli();
+	if (!memcmp(data, last, length)) {
+		SREG = intr_state;
+		return 0;
+	}
+	if ((uint8_t)(extra_queue_tail - extra_queue_head) == REPORT_QUEUE_SIZE) {
+		usb_report_overflow(&extra_queue_full);
+		SREG = intr_state;
+		return -1;
+	}
+	extra_queue_full = 0;
+	memcpy(last, data, length);
+	i = extra_queue_tail++ & REPORT_QUEUE_MASK;
+	memcpy(extra_queue[i], data, length);
+	usb_report_queue_drain();
+	SREG = intr_state;
+	return 0;
+}
 
 
 /**************************************************************************
@@ -345,7 +862,7 @@ void usb_init(void)
         USB_CONFIG();				// start USB clock
         UDCON = 0;				// enable attach resistor
 	usb_configuration = 0;
-        UDIEN = (1<<EORSTE)|(1<<SOFE);
+        UDIEN = (1<<EORSTE)|(1<<SOFE)|(1<<SUSPE);
 	sei();
 }
 
@@ -371,40 +888,138 @@ int8_t usb_keyboard_press(uint8_t key, uint8_t modifier)
 	return usb_keyboard_send();
 }
 
-// send the contents of keyboard_keys and keyboard_modifier_keys
-int8_t usb_keyboard_send(void)
+// whether the host has suspended the bus
+uint8_t usb_suspended(void)
+{
+	return usb_suspend_state;
+}
+
+// start the PLL (if it's off), and unfreeze the USB clock
+// - must be called with interrupts disabled
+static void usb_clock_on(void)
 {
-	uint8_t i, intr_state, timeout;
+	if (!(PLLCSR & (1<<PLLE))) {
+		PLL_CONFIG();
+		while (!(PLLCSR & (1<<PLOCK))) ;
+	}
+	USBCON &= ~(1<<FRZCLK);
+}
+
+// ask the host to wake up, if the bus is suspended and the host has allowed
+// it; the resume itself is handled when the host drives it (WAKEUPI)
+void usb_remote_wakeup(void)
+{
+	uint8_t intr_state;
+
+	intr_state = SREG;
+	cli();
+	if (usb_suspend_state && usb_remote_wakeup_enabled
+	  && !(UDCON & (1<<RMWKUP))) {
+		usb_clock_on();
+		UDCON |= (1<<RMWKUP);
+	}
+	SREG = intr_state;
+}
+
+// the number of reports (on all queues) waiting for the host
+uint8_t usb_report_queue_depth(void)
+{
+	uint8_t intr_state, depth;
+
+	intr_state = SREG;
+	cli();
+	depth = (uint8_t)(keyboard_queue_tail - keyboard_queue_head)
+	      + (uint8_t)(extra_queue_tail - extra_queue_head);
+	SREG = intr_state;
+	return depth;
+}
+
+// the number of reports that can still be queued, on the fullest queue
+uint8_t usb_report_queue_room(void)
+{
+	uint8_t intr_state, keyboard, extra;
 
-	if (!usb_configuration) return -1;
 	intr_state = SREG;
 	cli();
-	UENUM = KEYBOARD_ENDPOINT;
-	timeout = UDFNUML + 50;
-	while (1) {
-		// are we ready to transmit?
-		if (UEINTX & (1<<RWAL)) break;
+	keyboard = (uint8_t)(keyboard_queue_tail - keyboard_queue_head);
+	extra    = (uint8_t)(extra_queue_tail - extra_queue_head);
+	SREG = intr_state;
+	return REPORT_QUEUE_SIZE - (keyboard > extra ? keyboard : extra);
+}
+
+// read a raw HID report into 'buf' (RAWHID_SIZE bytes), if one has arrived
+// - returns RAWHID_SIZE if one was read, 0 if not; never waits
+int8_t usb_rawhid_recv(uint8_t *buf)
+{
+	uint8_t intr_state, i;
+
+	if (!usb_configuration || usb_suspend_state) return 0;
+	intr_state = SREG;
+	cli();
+	UENUM = RAWHID_RX_ENDPOINT;
+	if (!(UEINTX & (1<<RWAL))) {
 		SREG = intr_state;
-		// has the USB gone offline?
-		if (!usb_configuration) return -1;
-		// have we waited too long?
-		if (UDFNUML == timeout) return -1;
-		// get ready to try checking again
-		intr_state = SREG;
-		cli();
-		UENUM = KEYBOARD_ENDPOINT;
+		return 0;
 	}
-	UEDATX = keyboard_modifier_keys;
-	UEDATX = 0;
-	for (i=0; i<6; i++) {
-		UEDATX = keyboard_keys[i];
+	for (i=0; i<RAWHID_SIZE; i++) {
+		*buf++ = UEDATX;
+	}
+	UEINTX = 0x6B;  // release the bank
+	SREG = intr_state;
+	return RAWHID_SIZE;
+}
+
+// send a raw HID report from 'buf' (RAWHID_SIZE bytes)
+// - returns 0 on success, -1 if the endpoint is still full (the host hasn't
+//   read the last one); never waits
+int8_t usb_rawhid_send(const uint8_t *buf)
+{
+	uint8_t intr_state;
+
+	if (!usb_configuration || usb_suspend_state) return -1;
+	intr_state = SREG;
+	cli();
+	UENUM = RAWHID_TX_ENDPOINT;
+	if (!(UEINTX & (1<<RWAL))) {
+		SREG = intr_state;
+		return -1;
 	}
+	usb_write(buf, RAWHID_SIZE);
 	UEINTX = 0x3A;
-	keyboard_idle_count = 0;
 	SREG = intr_state;
 	return 0;
 }
 
+// whether keys are being sent on the NKRO interface
+uint8_t usb_keyboard_nkro_active(void)
+{
+	return keyboard_protocol;
+}
+
+// send the contents of keyboard_keys and keyboard_modifier_keys (or of
+// keyboard_nkro_keys, if the host is using report protocol)
+// - queues the report, and returns right away (see "Report Queues")
+int8_t usb_keyboard_send(void)
+{
+	struct keyboard_report report;
+
+	if (!usb_configuration) return -1;
+	keyboard_report_dirty = 0;
+	if (keyboard_protocol) {
+		report.endpoint = NKRO_ENDPOINT;
+		usb_keyboard_build_nkro(report.data);
+	} else {
+		report.endpoint = KEYBOARD_ENDPOINT;
+		usb_keyboard_build_boot(report.data);
+		memset(report.data+KEYBOARD_SIZE, 0, NKRO_REPORT_SIZE-KEYBOARD_SIZE);
+	}
+	if (usb_keyboard_queue(&report)) {
+		keyboard_report_dirty = 1;
+		return -1;
+	}
+	return 0;
+}
+
 /**************************************************************************
  *
  *  Private Functions - not intended for general user consumption....
@@ -418,12 +1033,31 @@ int8_t usb_keyboard_send(void)
 //
 ISR(USB_GEN_vect)
 {
-	uint8_t intbits, i;  // used to declare a variable `t` as well, but it
-			     //   wasn't used ::Ben Blazak, 2012::
-	static uint8_t div4=0;
-
+	uint8_t intbits;  // used to declare variables `t` and `i` as well, but
+			  //   they weren't used ::Ben Blazak, 2012::
+	static uint8_t div4=0, sync_frames=0;
+	static uint16_t frames=0, sent_before=0;
+
+	// (the clock has to be running before the flags can be cleared)
+	if ((UDIEN & (1<<WAKEUPE)) && (UDINT & (1<<WAKEUPI))) {
+		usb_clock_on();
+	}
         intbits = UDINT;
         UDINT = 0;
+	// suspend: 3ms with no activity on the bus.  freeze the clock and
+	// stop the PLL (for the suspend current limit), and wait for any
+	// activity (a resume, or a reset)
+	if ((UDIEN & (1<<SUSPE)) && (intbits & (1<<SUSPI))) {
+		UDIEN = (UDIEN & ~(1<<SUSPE)) | (1<<WAKEUPE);
+		usb_suspend_state = 1;
+		USBCON |= (1<<FRZCLK);
+		PLLCSR &= ~(1<<PLLE);
+		return;
+	}
+	if ((UDIEN & (1<<WAKEUPE)) && (intbits & (1<<WAKEUPI))) {
+		UDIEN = (UDIEN & ~(1<<WAKEUPE)) | (1<<SUSPE);
+		usb_suspend_state = 0;
+	}
         if (intbits & (1<<EORSTI)) {
 		UENUM = 0;
 		UECONX = 1;
@@ -431,20 +1065,62 @@ ISR(USB_GEN_vect)
 		UECFG1X = EP_SIZE(ENDPOINT0_SIZE) | EP_SINGLE_BUFFER;
 		UEIENX = (1<<RXSTPE);
 		usb_configuration = 0;
+		usb_suspend_state = 0;
+		usb_remote_wakeup_enabled = 0;
+		UDIEN = (UDIEN & ~(1<<WAKEUPE)) | (1<<SUSPE);
+		usb_report_queue_clear();
+		keyboard_protocol = 1;
+		keyboard_report_dirty = 1;
+		consumer_report_dirty = 1;
+		system_report_dirty = 1;
+		mouse_buttons_sent = 0;
+		mouse_x = mouse_y = mouse_wheel = 0;
         }
 	if ((intbits & (1<<SOFI)) && usb_configuration) {
-		if (keyboard_idle_config && (++div4 & 3) == 0) {
+		// lock the scan tick to the frame (or to every Nth one), so
+		// the next report is ready just before the host asks (see
+		// `timer_sync()`)
+		if (usb_frames_per_sync && ++sync_frames >= usb_frames_per_sync) {
+			sync_frames = 0;
+			timer_sync_event();
+		}
+		usb_report_queue_drain();
+		// mouse motion is generated (and sent) once per frame
+		mousekeys_frame();
+		usb_mouse_send();
+		#if MAKEFILE_USB_RATE_TEST
+		// keep the keyboard endpoint full of (repeats of) the current
+		// report
+		if (keyboard_queue_head == keyboard_queue_tail) {
+			UENUM = keyboard_last.endpoint;
+			if (keyboard_last.endpoint && (UEINTX & (1<<RWAL))) {
+				usb_write( keyboard_last.data,
+					   keyboard_last.endpoint == NKRO_ENDPOINT
+					   ? NKRO_REPORT_SIZE : KEYBOARD_SIZE );
+				UEINTX = 0x3A;
+				usb_reports_sent++;
+			}
+		}
+		#endif
+		if (++frames == 1000) {
+			frames = 0;
+			usb_report_rate = usb_reports_sent - sent_before;
+			sent_before = usb_reports_sent;
+		}
+		// (idle reports only when nothing's queued, so they can't get
+		// ahead of anything)
+		if (keyboard_idle_config && (++div4 & 3) == 0
+		  && keyboard_queue_head == keyboard_queue_tail) {
 			UENUM = KEYBOARD_ENDPOINT;
 			if (UEINTX & (1<<RWAL)) {
 				keyboard_idle_count++;
 				if (keyboard_idle_count == keyboard_idle_config) {
+					uint8_t buf[KEYBOARD_SIZE];
 					keyboard_idle_count = 0;
-					UEDATX = keyboard_modifier_keys;
-					UEDATX = 0;
-					for (i=0; i<6; i++) {
-						UEDATX = keyboard_keys[i];
-					}
+					usb_keyboard_build_boot(buf);
+					usb_write(buf, KEYBOARD_SIZE);
 					UEINTX = 0x3A;
+					usb_reports_sent++;
 				}
 			}
 		}
@@ -556,7 +1232,7 @@ ISR(USB_COM_vect)
 			usb_configuration = wValue;
 			usb_send_in();
 			cfg = endpoint_config_table;
-			for (i=1; i<5; i++) {
+			for (i=1; i<=MAX_ENDPOINT; i++) {
 				UENUM = i;
 				en = pgm_read_byte(cfg++);
 				UECONX = en;
@@ -565,7 +1241,8 @@ ISR(USB_COM_vect)
 					UECFG1X = pgm_read_byte(cfg++);
 				}
 			}
-        		UERST = 0x1E;
+			// reset endpoints 1..MAX_ENDPOINT
+        		UERST = (1<<(MAX_ENDPOINT+1)) - 2;
         		UERST = 0;
 			return;
 		}
@@ -579,6 +1256,8 @@ ISR(USB_COM_vect)
 		if (bRequest == GET_STATUS) {
 			usb_wait_in_ready();
 			i = 0;
+			// device: bit 1 = remote wakeup
+			if (bmRequestType == 0x80 && usb_remote_wakeup_enabled) i = 2;
 			#ifdef SUPPORT_ENDPOINT_HALT
 			if (bmRequestType == 0x82) {
 				UENUM = wIndex;
@@ -591,6 +1270,13 @@ ISR(USB_COM_vect)
 			usb_send_in();
 			return;
 		}
+		// DEVICE_REMOTE_WAKEUP
+		if ((bRequest == CLEAR_FEATURE || bRequest == SET_FEATURE)
+		  && bmRequestType == 0x00 && wValue == 1) {
+			usb_remote_wakeup_enabled = (bRequest == SET_FEATURE);
+			usb_send_in();
+			return;
+		}
 		#ifdef SUPPORT_ENDPOINT_HALT
 		if ((bRequest == CLEAR_FEATURE || bRequest == SET_FEATURE)
 		  && bmRequestType == 0x02 && wValue == 0) {
@@ -612,12 +1298,10 @@ ISR(USB_COM_vect)
 		if (wIndex == KEYBOARD_INTERFACE) {
 			if (bmRequestType == 0xA1) {
 				if (bRequest == HID_GET_REPORT) {
+					uint8_t buf[KEYBOARD_SIZE];
+					usb_keyboard_build_boot(buf);
 					usb_wait_in_ready();
-					UEDATX = keyboard_modifier_keys;
-					UEDATX = 0;
-					for (i=0; i<6; i++) {
-						UEDATX = keyboard_keys[i];
-					}
+					usb_write(buf, KEYBOARD_SIZE);
 					usb_send_in();
 					return;
 				}
@@ -649,50 +1333,98 @@ ISR(USB_COM_vect)
 					return;
 				}
 				if (bRequest == HID_SET_PROTOCOL) {
+					// release everything on the interface
+					// we're leaving, so no keys are left
+					// stuck down there on the host
+					if (wValue != keyboard_protocol) {
+						struct keyboard_report report;
+						memset(&report, 0, sizeof(report));
+						report.endpoint = keyboard_protocol
+							? NKRO_ENDPOINT : KEYBOARD_ENDPOINT;
+						usb_keyboard_queue(&report);
+					}
 					keyboard_protocol = wValue;
+					keyboard_report_dirty = 1;
 					usb_send_in();
 					return;
 				}
 			}
 		}
+		if (wIndex == EXTRA_INTERFACE) {
+			uint8_t id = wValue;  // the report ID
+			if ( bmRequestType == 0xA1 && bRequest == HID_GET_REPORT
+			     && (id == REPORT_ID_SYSTEM || id == REPORT_ID_CONSUMER) ) {
+				uint8_t buf[EXTRA_REPORT_SIZE];
+				usb_extra_build(buf, id);
+				usb_wait_in_ready();
+				usb_write(buf, EXTRA_REPORT_LENGTH(id));
+				usb_send_in();
+				return;
+			}
+			if (bmRequestType == 0x21 && bRequest == HID_SET_IDLE) {
+				// reports are only sent when asked; nothing to do
+				usb_send_in();
+				return;
+			}
+		}
+		if (wIndex == MOUSE_INTERFACE) {
+			if (bmRequestType == 0xA1 && bRequest == HID_GET_REPORT) {
+				// (buttons only; motion is only sent once)
+				usb_wait_in_ready();
+				UEDATX = mouse_buttons;
+				UEDATX = 0;
+				UEDATX = 0;
+				UEDATX = 0;
+				usb_send_in();
+				return;
+			}
+			if (bmRequestType == 0x21 && bRequest == HID_SET_IDLE) {
+				// reports are only sent when asked; nothing to do
+				usb_send_in();
+				return;
+			}
+		}
+		if (wIndex == NKRO_INTERFACE) {
+			if (bmRequestType == 0xA1 && bRequest == HID_GET_REPORT) {
+				uint8_t buf[NKRO_REPORT_SIZE];
+				usb_keyboard_build_nkro(buf);
+				usb_wait_in_ready();
+				usb_write(buf, NKRO_REPORT_SIZE);
+				usb_send_in();
+				return;
+			}
+			if (bmRequestType == 0x21 && bRequest == HID_SET_IDLE) {
+				// reports are only sent when asked; nothing to do
+				usb_send_in();
+				return;
+			}
+		}
 	}
 	UECONX = (1<<STALLRQ) | (1<<EPEN);	// stall
 }
 
-int8_t usb_extra_send(uint8_t report_id, uint16_t data)
+// queues the report, and returns right away (see "Report Queues")
+static int8_t usb_extra_send(uint8_t report_id, volatile uint8_t *dirty)
 {
-	uint8_t intr_state, timeout;
+	uint8_t report[EXTRA_REPORT_SIZE];
 
 	if (!usb_configured()) return -1;
-	intr_state = SREG;
-	cli();
-	UENUM = EXTRA_ENDPOINT;
-	timeout = UDFNUML + 50;
-	while (1) {
-		// are we ready to transmit?
-		if (UEINTX & (1<<RWAL)) break;
-		SREG = intr_state;
-		// has the USB gone offline?
-		if (!usb_configured()) return -1;
-		// have we waited too long?
-		if (UDFNUML == timeout) return -1;
-		// get ready to try checking again
-		intr_state = SREG;
-		cli();
-		UENUM = EXTRA_ENDPOINT;
+	*dirty = 0;
+	usb_extra_build(report, report_id);
+	if (usb_extra_queue(report)) {
+		*dirty = 1;
+		return -1;
 	}
-
-	UEDATX = report_id;
-        UEDATX = data&0xFF;
-        UEDATX = (data>>8)&0xFF;
-
-	UEINTX = 0x3A;
-	SREG = intr_state;
 	return 0;
 }
 
-int8_t usb_extra_consumer_send()
+int8_t usb_extra_consumer_send(void)
+{
+	return usb_extra_send(REPORT_ID_CONSUMER, &consumer_report_dirty);
+}
+
+int8_t usb_extra_system_send(void)
 {
-	return usb_extra_send(REPORT_ID_CONSUMER, consumer_key);
+	return usb_extra_send(REPORT_ID_SYSTEM, &system_report_dirty);
 }
 
@@ -5,6 +5,8 @@
 
 void usb_init(void);			// initialize everything
 uint8_t usb_configured(void);		// is the USB port configured
+uint8_t usb_suspended(void);		// is the bus suspended
+void usb_remote_wakeup(void);		// ask the host to resume
 
 int8_t usb_keyboard_press(uint8_t key, uint8_t modifier);
 int8_t usb_keyboard_send(void);
@@ -12,7 +14,22 @@ extern uint8_t keyboard_modifier_keys;
 extern uint8_t keyboard_keys[6];
 extern volatile uint8_t keyboard_leds;
 
-extern uint16_t consumer_key;
+// n-key rollover: one bit per keycode, for keycodes below this (the
+// modifiers, 0xE0..0xE7, are in `keyboard_modifier_keys`)
+#define KEYBOARD_NKRO_KEYS	224
+extern uint8_t keyboard_nkro_keys[KEYBOARD_NKRO_KEYS/8];
+uint8_t usb_keyboard_nkro_active(void);
+
+// consumer keys (up to CONSUMER_KEYS at once, in any slots; 0 = empty) and
+// the system control key currently pressed
+#define CONSUMER_KEYS	4
+extern uint16_t consumer_keys[CONSUMER_KEYS];
+extern uint16_t system_key;
+
+// mouse buttons pressed (bit 0 = button 1), and motion waiting to be sent (only
+// to be touched from the start of frame interrupt; see "lib/mousekeys.c")
+extern volatile uint8_t mouse_buttons;
+extern int16_t mouse_x, mouse_y, mouse_wheel;
 
 // This file does not include the HID debug functions, so these empty
 // macros replace them with nothing, so users can compile code that
@@ -20,7 +37,32 @@ extern uint16_t consumer_key;
 #define usb_debug_putchar(c)
 #define usb_debug_flush_output()
 
-int8_t usb_extra_consumer_send();
+int8_t usb_extra_consumer_send(void);
+int8_t usb_extra_system_send(void);
+
+// times a send queue was full, reports waiting to be sent, and room left
+extern uint16_t usb_report_overflows;
+uint8_t usb_report_queue_depth(void);
+uint8_t usb_report_queue_room(void);
+
+// raw HID (vendor defined) reports; see "src/telemetry.c"
+#define RAWHID_SIZE	64
+int8_t usb_rawhid_recv(uint8_t *buf);
+int8_t usb_rawhid_send(const uint8_t *buf);
+
+// reports sent (running count), and reports sent in the last second
+extern uint16_t usb_reports_sent;
+extern uint16_t usb_report_rate;
+
+// start of frame interrupts per call to `timer_sync_event()`, i.e. frames
+// per scan tick (0: never call it)
+extern volatile uint8_t usb_frames_per_sync;
+
+// set whenever the state behind a report changes (by whoever changes it);
+// cleared when the report is sent, so callers can send only on change
+extern volatile uint8_t keyboard_report_dirty;
+extern volatile uint8_t consumer_report_dirty;
+extern volatile uint8_t system_report_dirty;
 
 #if 0  // removed in favor of equivalent code elsewhere ::Ben Blazak, 2012::
 
@@ -193,7 +235,7 @@ int8_t usb_extra_consumer_send();
 			((s) == 16 ? 0x10 :	\
 			             0x00)))
 
-#define MAX_ENDPOINT		4
+#define MAX_ENDPOINT		6
 
 #define LSB(n) (n & 255)
 #define MSB(n) ((n >> 8) & 255)
@@ -0,0 +1,93 @@
+/* ----------------------------------------------------------------------------
+ * Per-key debouncing : code
+ *
+ * Sits between the matrix scan (`kb_update_matrix()`) and the change
+ * detection loop in `main()`.  Each key has its own debounced state and
+ * counter, so a bouncing key never delays (or is delayed by) any other.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2026 The ergodox-firmware contributors
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../keyboard/matrix.h"
+#include "./debounce.h"
+
+// ----------------------------------------------------------------------------
+
+// may be changed at runtime
+uint8_t debounce_mode  = MAKEFILE_DEBOUNCE_MODE;
+uint8_t debounce_ticks = DEBOUNCE_MS_TO_TICKS( MAKEFILE_DEBOUNCE_TIME,
+					       MAKEFILE_SCAN_RATE );
+
+static uint16_t _state[KB_ROWS];              // the debounced state
+static uint16_t _busy[KB_ROWS];               // keys with `_count` != 0
+static uint8_t  _count[KB_ROWS][KB_COLUMNS];  // see `debounce_update()`
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Update the debounced matrix, given a freshly scanned one
+ *
+ * Arguments
+ * - 'raw': the matrix, as just scanned
+ * - 'debounced': the matrix to write the debounced state of every key to
+ *
+ * Returns
+ * - whether the debounced state of any key changed
+ *
+ * Notes
+ * - Should be called exactly once per scan, since counts are in scans
+ * - '_count' is
+ *   - EAGER: the number of scans left for which the key is locked out
+ *   - DEFERRED: the number of consecutive scans the key has disagreed with
+ *     its debounced state
+ * - Only keys that differ from their debounced state, or that have a count
+ *   running, are looked at individually; rows with neither are skipped
+ */
+bool debounce_update( uint16_t raw[KB_ROWS],
+		      uint16_t debounced[KB_ROWS] ) {
+	bool changed = false;
+
+	for (uint8_t row=0; row<KB_ROWS; row++) {
+		uint16_t diff = raw[row] ^ _state[row];
+		uint16_t todo = diff | _busy[row];
+
+		for (uint8_t col=0; todo; col++, todo >>= 1) {
+			if (!(todo & 1))
+				continue;
+
+			uint16_t  bit   = (1U<<col);
+			uint8_t * count = &_count[row][col];
+
+			if (debounce_mode == DEBOUNCE_EAGER) {
+				if (*count) {
+					(*count)--;
+				} else if (diff & bit) {
+					_state[row] ^= bit;
+					*count = debounce_ticks;
+					changed = true;
+				}
+			} else {
+				if (!(diff & bit)) {
+					*count = 0;
+				} else if (++(*count) >= debounce_ticks) {
+					_state[row] ^= bit;
+					*count = 0;
+					changed = true;
+				}
+			}
+
+			if (*count) _busy[row] |=  bit;
+			else        _busy[row] &= ~bit;
+		}
+
+		debounced[row] = _state[row];
+	}
+
+	return changed;
+}
+
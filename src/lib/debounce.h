@@ -0,0 +1,44 @@
+/* ----------------------------------------------------------------------------
+ * Per-key debouncing : exports
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2026 The ergodox-firmware contributors
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#ifndef LIB__DEBOUNCE_h
+	#define LIB__DEBOUNCE_h
+
+	#include <stdbool.h>
+	#include <stdint.h>
+	#include "../keyboard/matrix.h"
+
+	// --------------------------------------------------------------------
+
+	/*
+	 * debounce modes
+	 * - EAGER: report the first edge immediately, then ignore the key for
+	 *   `debounce_ticks` scans
+	 * - DEFERRED: report an edge only after the key has read the same for
+	 *   `debounce_ticks` consecutive scans
+	 */
+	#define  DEBOUNCE_EAGER     0
+	#define  DEBOUNCE_DEFERRED  1
+
+	// convert a time in ms to a number of scans, rounding up
+	#define  DEBOUNCE_MS_TO_TICKS(ms, scan_rate)	\
+		( ((uint32_t)(ms) * (scan_rate) + 999) / 1000 )
+
+	// --------------------------------------------------------------------
+
+	extern uint8_t debounce_mode;
+	extern uint8_t debounce_ticks;
+
+	// --------------------------------------------------------------------
+
+	bool debounce_update( uint16_t raw[KB_ROWS],
+			      uint16_t debounced[KB_ROWS] );
+
+#endif
+
@@ -9,8 +9,10 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <avr/pgmspace.h>
 #include "../../lib-other/pjrc/usb_keyboard/usb_keyboard.h"
 #include "../../lib/usb/usage-page/keyboard.h"
+#include "../../lib/mousekeys.h"
 #include "../../keyboard/layout.h"
 #include "../../keyboard/matrix.h"
 #include "../../main.h"
@@ -19,12 +21,36 @@
 /*
  * MediaCodeLookupTable is used to translate from enumeration in keyboard.h to
  *  consumer key scan code in usb_keyboard.h
+ *
+ * A layout may define `KB_LAYOUT_MEDIAKEY_USAGES` (in its header) as a list
+ *  of 16-bit consumer usages to use instead, in which case its media keys are
+ *  indices into that list
  */
-static const uint16_t _media_code_lookup_table[] = {
+static const uint16_t PROGMEM _media_code_lookup_table[] = {
+#ifdef KB_LAYOUT_MEDIAKEY_USAGES
+	KB_LAYOUT_MEDIAKEY_USAGES
+#else
 	TRANSPORT_PLAY_PAUSE, /* MEDIAKEY_PLAY_PAUSE */
 	TRANSPORT_PREV_TRACK, /* MEDIAKEY_PREV_TRACK */
 	TRANSPORT_NEXT_TRACK, /* MEDIAKEY_NEXT_TRACK */
+	TRANSPORT_STOP,       /* MEDIAKEY_STOP */
+	AUDIO_MUTE,           /* MEDIAKEY_MUTE */
+	AUDIO_VOL_UP,         /* MEDIAKEY_VOLUME_UP */
+	AUDIO_VOL_DOWN,       /* MEDIAKEY_VOLUME_DOWN */
+	TRANSPORT_EJECT,      /* MEDIAKEY_EJECT */
+	AL_EMAIL,             /* MEDIAKEY_EMAIL */
+	AL_CALCULATOR,        /* MEDIAKEY_CALCULATOR */
+	AL_LOCAL_BROWSER,     /* MEDIAKEY_MY_COMPUTER */
+	AC_SEARCH,            /* MEDIAKEY_WWW_SEARCH */
+	AC_HOME,              /* MEDIAKEY_WWW_HOME */
+	AC_BACK,              /* MEDIAKEY_WWW_BACK */
+	AC_FORWARD,           /* MEDIAKEY_WWW_FORWARD */
+	AC_STOP,              /* MEDIAKEY_WWW_STOP */
+	AC_REFRESH,           /* MEDIAKEY_WWW_REFRESH */
+	AC_BOOKMARKS,         /* MEDIAKEY_WWW_FAVORITES */
+#endif
 };
+#define MEDIA_CODES  ( sizeof(_media_code_lookup_table) / sizeof(uint16_t) )
 
 // ----------------------------------------------------------------------------
 
@@ -39,12 +65,17 @@ static const uint16_t _media_code_lookup_table[] = {
  * - Because of the way USB does things, what this actually does is either add
  *   or remove 'keycode' from the list of currently pressed keys, to be sent at
  *   the end of the current cycle (see main.c)
+ * - There are two lists: the NKRO bitmap, which holds every key, and the 6KRO
+ *   boot report, which (for BIOS and the like) holds only the first 6.  Which
+ *   one gets sent is up to the host (see "usb_keyboard.c").
  */
 void _kbfun_press_release(bool press, uint8_t keycode) {
 	// no-op
 	if (keycode == 0)
 		return;
 
+	keyboard_report_dirty = true;
+
 	// modifier keys
 	switch (keycode) {
 		case KEY_LeftControl:  (press)
@@ -82,6 +113,13 @@ void _kbfun_press_release(bool press, uint8_t keycode) {
 	}
 
 	// all others
+	if (keycode < KEYBOARD_NKRO_KEYS) {
+		if (press)
+			keyboard_nkro_keys[keycode>>3] |=  (1<<(keycode&7));
+		else
+			keyboard_nkro_keys[keycode>>3] &= ~(1<<(keycode&7));
+	}
+
 	for (uint8_t i=0; i<6; i++) {
 		if (press) {
 			if (keyboard_keys[i] == 0) {
@@ -122,6 +160,9 @@ bool _kbfun_is_pressed(uint8_t keycode) {
 	}
 
 	// all others
+	if (keycode < KEYBOARD_NKRO_KEYS)
+		return keyboard_nkro_keys[keycode>>3] & (1<<(keycode&7));
+
 	for (uint8_t i=0; i<6; i++)
 		if (keyboard_keys[i] == keycode)
 			return true;
@@ -129,16 +170,88 @@ bool _kbfun_is_pressed(uint8_t keycode) {
 	return false;
 }
 
+/*
+ * Generate a consumer (media, application launch, ...) keypress or keyrelease
+ *
+ * Arguments
+ * - press: whether to generate a keypress (true) or keyrelease (false)
+ * - usage: the consumer page usage to use (any 16-bit value)
+ *
+ * Note
+ * - Up to `CONSUMER_KEYS` may be down at once; a press with every slot full
+ *   is ignored (as is its release)
+ */
+void _kbfun_consumer_press_release(bool press, uint16_t usage) {
+	uint8_t empty = CONSUMER_KEYS;
+
+	if (usage == 0)
+		return;
+
+	for (uint8_t i=0; i<CONSUMER_KEYS; i++) {
+		if (consumer_keys[i] == usage) {
+			if (!press) {
+				consumer_keys[i] = 0;
+				consumer_report_dirty = true;
+			}
+			return;
+		}
+		if (!consumer_keys[i] && empty == CONSUMER_KEYS)
+			empty = i;
+	}
+
+	if (press && empty < CONSUMER_KEYS) {
+		consumer_keys[empty] = usage;
+		consumer_report_dirty = true;
+	}
+}
+
 void _kbfun_mediakey_press_release(bool press, uint8_t keycode) {
-	uint16_t mediakey_code = _media_code_lookup_table[keycode];
+	if (keycode >= MEDIA_CODES)
+		return;
+	_kbfun_consumer_press_release(
+			press, pgm_read_word(&_media_code_lookup_table[keycode]) );
+}
+
+/*
+ * Generate a system control (power down, sleep, wake up) keypress or
+ * keyrelease
+ *
+ * Arguments
+ * - press: whether to generate a keypress (true) or keyrelease (false)
+ * - usage: the generic desktop page usage to use (see `SYSTEM_...`)
+ *
+ * Note
+ * - Only one system control key can be down at once, so a release only
+ *   counts for the most recently pressed one
+ */
+void _kbfun_system_press_release(bool press, uint8_t usage) {
 	if (press) {
-		consumer_key = mediakey_code;
-	} else {
-		// Only one key can be pressed at a time so only clear the keypress for
-		//  active key (most recently pressed)
-		if (mediakey_code == consumer_key) {
-			consumer_key = 0;
-		}
+		system_key = usage;
+		system_report_dirty = true;
+	} else if (usage == system_key) {
+		system_key = 0;
+		system_report_dirty = true;
+	}
+}
+
+/*
+ * Press or release a mouse button, or start or stop moving the pointer or
+ * wheel
+ *
+ * Arguments
+ * - press: whether to generate a keypress (true) or keyrelease (false)
+ * - keycode: one of `MOUSEKEY_...`
+ *
+ * Note
+ * - Nothing is sent from here: mouse reports go out once per USB frame (see
+ *   "lib/mousekeys.c")
+ */
+void _kbfun_mousekey_press_release(bool press, uint8_t keycode) {
+	if (keycode <= MOUSEKEY_BUTTON_5) {
+		if (press) mouse_buttons |=  (1<<keycode);
+		else       mouse_buttons &= ~(1<<keycode);
+	} else if (keycode >= MOUSEKEY_UP && keycode <= MOUSEKEY_WHEEL_DOWN) {
+		mousekeys_move(press, 1<<(keycode-MOUSEKEY_UP));
 	}
 }
 
@@ -21,7 +21,10 @@
 
 	void _kbfun_press_release     (bool press, uint8_t keycode);
 	bool _kbfun_is_pressed        (uint8_t keycode);
+	void _kbfun_consumer_press_release (bool press, uint16_t usage);
 	void _kbfun_mediakey_press_release (bool press, uint8_t keycode);
+	void _kbfun_system_press_release   (bool press, uint8_t usage);
+	void _kbfun_mousekey_press_release (bool press, uint8_t keycode);
 
 #endif
 
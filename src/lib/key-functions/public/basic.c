@@ -14,10 +14,6 @@
 
 // ----------------------------------------------------------------------------
 
-#define  MAX_LAYER_PUSH_POP_FUNCTIONS  10
-
-// ----------------------------------------------------------------------------
-
 // convenience macros
 #define  LAYER         main_arg_layer
 #define  LAYER_OFFSET  main_arg_layer_offset
@@ -96,86 +92,75 @@ void kbfun_transparent(void) {
 
 /* ----------------------------------------------------------------------------
  * layer push/pop functions
+ *
+ * The layer is the keycode given in the keymap.  Each layer has one slot for
+ * the id of the element its "push" (or "sticky", or "toggle") key put on the
+ * stack, so its "pop" key takes out that element, and only that one.
+ *
+ * Elements can also be popped from elsewhere (a "sticky once" layer pops
+ * itself, in "main.c"), and their ids given out again; so a slot is only
+ * trusted (see `layer_id()`) while its element is on the stack, and still on
+ * that slot's layer.
  * ------------------------------------------------------------------------- */
 
-// While there are only MAX_LAYER_PUSH_POP_FUNCTIONS number of layer functions,
-//  there are 1 + MAX_LAYER_PUSH_POP_FUNCTIONS layer ids because we still have
-//  layer 0 even if we will never have a push or pop function for it
-static uint8_t layer_ids[1 + MAX_LAYER_PUSH_POP_FUNCTIONS];
+static uint8_t layer_ids[KB_LAYERS];
 
-static void layer_push(uint8_t local_id) {
-	uint8_t keycode = kb_layout_get(LAYER, ROW, COL);
-	main_layers_pop_id(layer_ids[local_id]);
+/*
+ * Returns
+ * - the layer given in the keymap for the current key, or `KB_LAYERS` if
+ *   it's out of range (which these functions ignore)
+ */
+static uint8_t layer_get(void) {
+	uint8_t layer = kb_layout_get(LAYER, ROW, COL);
+	return (layer < KB_LAYERS) ? layer : KB_LAYERS;
+}
+
+/*
+ * Returns
+ * - the id of the element pushed for 'layer', or 0 if there isn't one (any
+ *   more)
+ */
+static uint8_t layer_id(uint8_t layer) {
+	if (!main_layers_has_id(layer_ids[layer], layer))
+		layer_ids[layer] = 0;
+	return layer_ids[layer];
+}
+
+static void layer_pop(uint8_t layer) {
+	main_layers_pop_id(layer_id(layer));
+	layer_ids[layer] = 0;
+	kb_led_layer_off(layer);
+}
+
+static void layer_push(uint8_t layer) {
+	layer_pop(layer);
 	// Only the topmost layer on the stack should be in sticky once state, pop
 	//  the top layer if it is in sticky once state
 	uint8_t topSticky = main_layers_peek_sticky(0);
 	if (topSticky == eStickyOnceDown || topSticky == eStickyOnceUp) {
-		main_layers_pop_id(main_layers_peek(0));
-	}
-	layer_ids[local_id] = main_layers_push(keycode, eStickyNone);
-}
-
-static void layer_sticky(uint8_t local_id) {
-	uint8_t keycode = kb_layout_get(LAYER, ROW, COL);
-	if (IS_PRESSED) {
-		uint8_t topLayer = main_layers_peek(0);
-		uint8_t topSticky = main_layers_peek_sticky(0);
-		main_layers_pop_id(layer_ids[local_id]);
-		if (topLayer == local_id) {
-			if (topSticky == eStickyOnceUp)
-				layer_ids[local_id] = main_layers_push(keycode, eStickyLock);
-		}
-		else
-		{
-			// only the topmost layer on the stack should be in sticky once state
-			if (topSticky == eStickyOnceDown || topSticky == eStickyOnceUp) {
-				main_layers_pop_id(layer_ids[topLayer]);
-			}
-			layer_ids[local_id] = main_layers_push(keycode, eStickyOnceDown);
-			// this should be the only place we care about this flag being cleared
-			main_arg_any_non_trans_key_pressed = false;
-		}
-	}
-	else
-	{
-		uint8_t topLayer = main_layers_peek(0);
-		uint8_t topSticky = main_layers_peek_sticky(0);
-		if (topLayer == local_id) {
-			if (topSticky == eStickyOnceDown) {
-				// When releasing this sticky key, pop the layer always
-				main_layers_pop_id(layer_ids[local_id]);
-				if (!main_arg_any_non_trans_key_pressed) {
-					// If no key defined for this layer (a non-transparent key)
-					//  was pressed, push the layer again, but in the
-					//  StickyOnceUp state
-					layer_ids[local_id] = main_layers_push(keycode, eStickyOnceUp);
-				}
-			}
-		}
+		layer_pop(main_layers_peek(0));
 	}
-}
-
-static void layer_pop(uint8_t local_id) {
-	main_layers_pop_id(layer_ids[local_id]);
-	layer_ids[local_id] = 0;
+	layer_ids[layer] = main_layers_push(layer, eStickyNone);
+	kb_led_layer_on(layer);
 }
 
 /*
  * [name]
- *   Layer push #1
+ *   Layer push
  *
  * [description]
  *   Push a layer element containing the layer value specified in the keymap to
  *   the top of the stack, and record the id of that layer element
  */
-void kbfun_layer_push_1(void) {
-	layer_push(1);
-    kb_led_layer1_on();
+void kbfun_layer_push(void) {
+	uint8_t layer = layer_get();
+	if (layer < KB_LAYERS)
+		layer_push(layer);
 }
 
 /*
  * [name]
- *   Layer sticky cycle #1
+ *   Layer sticky cycle
  *
  * [description]
  *  This function gives similar behavior to sticky keys for modifiers available
@@ -208,364 +193,101 @@ void kbfun_layer_push_1(void) {
  *      state when the layer sticky key was pressed again. The layer will be
  *      popped if the function is invoked on a subsequent keypress.
  */
-void kbfun_layer_sticky_1  (void) {
-	layer_sticky(1);
-}
-
-/*
- * [name]
- *   Layer pop #1
- *
- * [description]
- *   Pop the layer element created by the corresponding "layer push" function
- *   out of the layer stack (no matter where it is in the stack, without
- *   touching any other elements)
- */
-void kbfun_layer_pop_1(void) {
-	layer_pop(1);
-    kb_led_layer1_off();
-}
-
-/*
- * [name]
- *   Layer push #2
- *
- * [description]
- *   Push a layer element containing the layer value specified in the keymap to
- *   the top of the stack, and record the id of that layer element
- */
-void kbfun_layer_push_2(void) {
-	layer_push(2);
-    kb_led_layer2_on();
-}
-
-/*
- * [name]
- *   Layer sticky cycle #2
- *
- * [description]
- *   See the description of kbfun_layer_sticky_1()
- */
-void kbfun_layer_sticky_2  (void) {
-	layer_sticky(2);
-}
-
-/*
- * [name]
- *   Layer pop #2
- *
- * [description]
- *   Pop the layer element created by the corresponding "layer push" function
- *   out of the layer stack (no matter where it is in the stack, without
- *   touching any other elements)
- */
-void kbfun_layer_pop_2(void) {
-	layer_pop(2);
-    kb_led_layer2_off();
-}
-
-/*
- * [name]
- *   Layer push #3
- *
- * [description]
- *   Push a layer element containing the layer value specified in the keymap to
- *   the top of the stack, and record the id of that layer element
- */
-void kbfun_layer_push_3(void) {
-	layer_push(3);
-    kb_led_layer3_on();
-}
-
-/*
- * [name]
- *   Layer sticky cycle #3
- *
- * [description]
- *   See the description of kbfun_layer_sticky_1()
- */
-void kbfun_layer_sticky_3  (void) {
-	layer_sticky(3);
-}
-
-/*
- * [name]
- *   Layer pop #3
- *
- * [description]
- *   Pop the layer element created by the corresponding "layer push" function
- *   out of the layer stack (no matter where it is in the stack, without
- *   touching any other elements)
- */
-void kbfun_layer_pop_3(void) {
-	layer_pop(3);
-    kb_led_layer3_off();
-}
-
-/*
- * [name]
- *   Layer push #4
- *
- * [description]
- *   Push a layer element containing the layer value specified in the keymap to
- *   the top of the stack, and record the id of that layer element
- */
-void kbfun_layer_push_4(void) {
-	layer_push(4);
-    kb_led_layer4_on();
-}
-
-/*
- * [name]
- *   Layer sticky cycle #4
- *
- * [description]
- *   See the description of kbfun_layer_sticky_1()
- */
-void kbfun_layer_sticky_4  (void) {
-	layer_sticky(4);
-}
-
-/*
- * [name]
- *   Layer pop #4
- *
- * [description]
- *   Pop the layer element created by the corresponding "layer push" function
- *   out of the layer stack (no matter where it is in the stack, without
- *   touching any other elements)
- */
-void kbfun_layer_pop_4(void) {
-	layer_pop(4);
-    kb_led_layer4_off();
-}
-
-/*
- * [name]
- *   Layer push #5
- *
- * [description]
- *   Push a layer element containing the layer value specified in the keymap to
- *   the top of the stack, and record the id of that layer element
- */
-void kbfun_layer_push_5(void) {
-	layer_push(5);
-    kb_led_layer5_on();
-}
+void kbfun_layer_sticky(void) {
+	uint8_t layer = layer_get();
+	if (layer >= KB_LAYERS)
+		return;
 
-/*
- * [name]
- *   Layer sticky cycle #5
- *
- * [description]
- *   See the description of kbfun_layer_sticky_1()
- */
-void kbfun_layer_sticky_5  (void) {
-	layer_sticky(5);
-}
-
-/*
- * [name]
- *   Layer pop #5
- *
- * [description]
- *   Pop the layer element created by the corresponding "layer push" function
- *   out of the layer stack (no matter where it is in the stack, without
- *   touching any other elements)
- */
-void kbfun_layer_pop_5(void) {
-	layer_pop(5);
-    kb_led_layer5_off();
-}
-
-/*
- * [name]
- *   Layer push #6
- *
- * [description]
- *   Push a layer element containing the layer value specified in the keymap to
- *   the top of the stack, and record the id of that layer element
- */
-void kbfun_layer_push_6(void) {
-	layer_push(6);
-    kb_led_layer6_on();
-}
-
-/*
- * [name]
- *   Layer sticky cycle #6
- *
- * [description]
- *   See the description of kbfun_layer_sticky_1()
- */
-void kbfun_layer_sticky_6  (void) {
-	layer_sticky(6);
-}
-
-/*
- * [name]
- *   Layer pop #6
- *
- * [description]
- *   Pop the layer element created by the corresponding "layer push" function
- *   out of the layer stack (no matter where it is in the stack, without
- *   touching any other elements)
- */
-void kbfun_layer_pop_6(void) {
-	layer_pop(6);
-    kb_led_layer6_off();
-}
-
-/*
- * [name]
- *   Layer push #7
- *
- * [description]
- *   Push a layer element containing the layer value specified in the keymap to
- *   the top of the stack, and record the id of that layer element
- */
-void kbfun_layer_push_7(void) {
-	layer_push(7);
-    kb_led_layer8_on();
-}
-
-/*
- * [name]
- *   Layer sticky cycle #7
- *
- * [description]
- *   See the description of kbfun_layer_sticky_1()
- */
-void kbfun_layer_sticky_7  (void) {
-	layer_sticky(7);
-}
-
-/*
- * [name]
- *   Layer pop #7
- *
- * [description]
- *   Pop the layer element created by the corresponding "layer push" function
- *   out of the layer stack (no matter where it is in the stack, without
- *   touching any other elements)
- */
-void kbfun_layer_pop_7(void) {
-	layer_pop(7);
-    kb_led_layer7_off();
-}
-
-/*
- * [name]
- *   Layer push #8
- *
- * [description]
- *   Push a layer element containing the layer value specified in the keymap to
- *   the top of the stack, and record the id of that layer element
- */
-void kbfun_layer_push_8(void) {
-	layer_push(8);
-    kb_led_layer8_on();
-}
-
-/*
- * [name]
- *   Layer sticky cycle #8
- *
- * [description]
- *   See the description of kbfun_layer_sticky_1()
- */
-void kbfun_layer_sticky_8  (void) {
-	layer_sticky(8);
-}
-
-/*
- * [name]
- *   Layer pop #8
- *
- * [description]
- *   Pop the layer element created by the corresponding "layer push" function
- *   out of the layer stack (no matter where it is in the stack, without
- *   touching any other elements)
- */
-void kbfun_layer_pop_8(void) {
-	layer_pop(8);
-    kb_led_layer8_off();
-}
-
-/*
- * [name]
- *   Layer push #9
- *
- * [description]
- *   Push a layer element containing the layer value specified in the keymap to
- *   the top of the stack, and record the id of that layer element
- */
-void kbfun_layer_push_9(void) {
-	layer_push(9);
-    kb_led_layer9_on();
+	if (IS_PRESSED) {
+		uint8_t topLayer = main_layers_peek(0);
+		uint8_t topSticky = main_layers_peek_sticky(0);
+		layer_pop(layer);
+		if (topLayer == layer) {
+			if (topSticky == eStickyOnceUp)
+				layer_ids[layer] = main_layers_push(layer, eStickyLock);
+		}
+		else
+		{
+			// only the topmost layer on the stack should be in sticky once state
+			if (topSticky == eStickyOnceDown || topSticky == eStickyOnceUp) {
+				layer_pop(topLayer);
+			}
+			layer_ids[layer] = main_layers_push(layer, eStickyOnceDown);
+			// this should be the only place we care about this flag being cleared
+			main_arg_any_non_trans_key_pressed = false;
+		}
+	}
+	else
+	{
+		uint8_t topLayer = main_layers_peek(0);
+		uint8_t topSticky = main_layers_peek_sticky(0);
+		if (topLayer == layer) {
+			if (topSticky == eStickyOnceDown) {
+				// When releasing this sticky key, pop the layer always
+				layer_pop(layer);
+				if (!main_arg_any_non_trans_key_pressed) {
+					// If no key defined for this layer (a non-transparent key)
+					//  was pressed, push the layer again, but in the
+					//  StickyOnceUp state
+					layer_ids[layer] = main_layers_push(layer, eStickyOnceUp);
+				}
+			}
+		}
+	}
 }
 
 /*
  * [name]
- *   Layer sticky cycle #9
+ *   Layer pop
  *
  * [description]
- *   See the description of kbfun_layer_sticky_1()
+ *   Pop the layer element created by the "layer push" (or "sticky", or
+ *   "toggle") function for the layer specified in the keymap out of the layer
+ *   stack (no matter where it is in the stack, without touching any other
+ *   elements)
  */
-void kbfun_layer_sticky_9  (void) {
-	layer_sticky(9);
+void kbfun_layer_pop(void) {
+	uint8_t layer = layer_get();
+	if (layer < KB_LAYERS)
+		layer_pop(layer);
 }
 
 /*
  * [name]
- *   Layer pop #9
+ *   Layer toggle
  *
  * [description]
- *   Pop the layer element created by the corresponding "layer push" function
- *   out of the layer stack (no matter where it is in the stack, without
- *   touching any other elements)
- */
-void kbfun_layer_pop_9(void) {
-	layer_pop(9);
-    kb_led_layer9_off();
-}
-
-/*
- * [name]
- *   Layer push #10
+ *   Pop the layer specified in the keymap if it was pushed by one of these
+ *   functions (and is still on the stack), or push it if not
  *
- * [description]
- *   Push a layer element containing the layer value specified in the keymap to
- *   the top of the stack, and record the id of that layer element
+ * [note]
+ *   Meant to be assigned as a press function only
  */
-void kbfun_layer_push_10(void) {
-	layer_push(10);
-    kb_led_layer10_on();
-}
+void kbfun_layer_toggle(void) {
+	uint8_t layer = layer_get();
+	if (layer >= KB_LAYERS)
+		return;
 
-/*
- * [name]
- *   Layer sticky cycle #10
- *
- * [description]
- *   See the description of kbfun_layer_sticky_1()
- */
-void kbfun_layer_sticky_10  (void) {
-	layer_sticky(10);
+	if (layer_id(layer))
+		layer_pop(layer);
+	else
+		layer_push(layer);
 }
 
 /*
  * [name]
- *   Layer pop #10
+ *   Layer pop all
  *
  * [description]
- *   Pop the layer element created by the corresponding "layer push" function
- *   out of the layer stack (no matter where it is in the stack, without
- *   touching any other elements)
+ *   Pop every element off the layer stack (leaving only layer 0), all at once
  */
-void kbfun_layer_pop_10(void) {
-	layer_pop(10);
-    kb_led_layer10_off();
+void kbfun_layer_pop_all(void) {
+	main_layers_pop_all();
+	for (uint8_t layer=0; layer<KB_LAYERS; layer++)
+		if (layer_ids[layer]) {
+			layer_ids[layer] = 0;
+			kb_led_layer_off(layer);
+		}
 }
 
 /* ----------------------------------------------------------------------------
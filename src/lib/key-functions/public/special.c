@@ -99,8 +99,6 @@ void kbfun_2_keys_capslock_press_release(void) {
  * numpad functions
  * ------------------------------------------------------------------------- */
 
-static uint8_t numpad_layer_id;
-
 static inline void numpad_toggle_numlock(void) {
 	_kbfun_press_release(true, KEY_LockingNumLock);
 	usb_keyboard_send();
@@ -113,18 +111,16 @@ static inline void numpad_toggle_numlock(void) {
  *   Numpad on
  *
  * [description]
- *   Set the numpad to on (put the numpad layer, specified in the keymap, in an
- *   element at the top of the layer stack, and record that element's id) and
- *   toggle numlock (regardless of whether or not numlock is currently on)
+ *   Set the numpad to on (push the numpad layer, specified in the keymap, as
+ *   "layer push" does) and toggle numlock (regardless of whether or not
+ *   numlock is currently on)
  *
  * [note]
  *   Meant to be assigned (along with "numpad off") instead of a normal numlock
  *   key
  */
 void kbfun_layer_push_numpad(void) {
-	uint8_t keycode = kb_layout_get(LAYER, ROW, COL);
-	main_layers_pop_id(numpad_layer_id);
-	numpad_layer_id = main_layers_push(keycode, eStickyNone);
+	kbfun_layer_push();
 	numpad_toggle_numlock();
 }
 
@@ -133,17 +129,16 @@ void kbfun_layer_push_numpad(void) {
  *   Numpad off
  *
  * [description]
- *   Set the numpad to off (pop the layer element created by "numpad on" out of
- *   the stack) and toggle numlock (regardless of whether or not numlock is
- *   currently on)
+ *   Set the numpad to off (pop the numpad layer, specified in the keymap, as
+ *   "layer pop" does) and toggle numlock (regardless of whether or not
+ *   numlock is currently on)
  *
  * [note]
  *   Meant to be assigned (along with "numpad on") instead of a normal numlock
  *   key
  */
 void kbfun_layer_pop_numpad(void) {
-	main_layers_pop_id(numpad_layer_id);
-	numpad_layer_id = 0;
+	kbfun_layer_pop();
 	numpad_toggle_numlock();
 }
 
@@ -153,7 +148,8 @@ void kbfun_layer_pop_numpad(void) {
  *
  * [description]
  *   Generate a keypress for a media key, such as play/pause, next track, or
- *   previous track
+ *   previous track (keycodes `MEDIAKEY_...`, or indices into the layout's own
+ *   `KB_LAYOUT_MEDIAKEY_USAGES`); several may be down at once
  *
  */
 void kbfun_mediakey_press_release(void) {
@@ -161,6 +157,33 @@ void kbfun_mediakey_press_release(void) {
 	_kbfun_mediakey_press_release(IS_PRESSED, keycode);
 }
 
+/*
+ * [name]
+ *   System Key Press Release
+ *
+ * [description]
+ *   Generate a keypress for a system control key: power down, sleep, or wake
+ *   up (keycodes `SYSTEM_...`, from "usb_keyboard.h")
+ */
+void kbfun_systemkey_press_release(void) {
+	uint8_t keycode = kb_layout_get(LAYER, ROW, COL);
+	_kbfun_system_press_release(IS_PRESSED, keycode);
+}
+
+/*
+ * [name]
+ *   Mouse Key Press Release
+ *
+ * [description]
+ *   Press a mouse button, or move the pointer or wheel for as long as the key
+ *   is held (keycodes `MOUSEKEY_...`).  The pointer accelerates the longer
+ *   it's moved (see "makefile-options").
+ */
+void kbfun_mousekey_press_release(void) {
+	uint8_t keycode = kb_layout_get(LAYER, ROW, COL);
+	_kbfun_mousekey_press_release(IS_PRESSED, keycode);
+}
+
 /* ----------------------------------------------------------------------------
  * ------------------------------------------------------------------------- */
 
@@ -0,0 +1,162 @@
+/* ----------------------------------------------------------------------------
+ * Mouse keys (pointer and wheel motion) : code
+ *
+ * Motion is generated once per USB frame (1 ms), from the start of frame
+ * interrupt (see "usb_keyboard.c"), rather than once per scan; so it's smooth,
+ * and doesn't depend on how long (or how regularly) scans take.  Keys only
+ * set which directions are held.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2026 The ergodox-firmware contributors
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <avr/pgmspace.h>
+#include "../lib-other/pjrc/usb_keyboard/usb_keyboard.h"
+#include "./mousekeys.h"
+
+// ----------------------------------------------------------------------------
+
+/*
+ * The acceleration curve
+ *
+ * - Speeds are in pixels per frame, as 16.16 fixed point numbers.
+ * - The pointer starts at `MOUSE_SPEED_MIN`, and reaches `MOUSE_SPEED_MAX`
+ *   (both in pixels per second) after `MOUSE_ACCEL_TIME` ms; in between,
+ *   speed follows (time)^`MOUSE_ACCEL_CURVE` (1 = linear, 2 = quadratic,
+ *   3 = cubic).
+ * - The curve is split into `SEGMENTS` pieces, each of which is linear.  The
+ *   speed at the start of each, and the amount to add per frame within each,
+ *   are worked out at compile time; so each frame costs only a few additions.
+ */
+
+#define  SEGMENTS        16
+#define  SEGMENT_FRAMES  ( MAKEFILE_MOUSE_ACCEL_TIME / SEGMENTS \
+			   ? MAKEFILE_MOUSE_ACCEL_TIME / SEGMENTS : 1 )
+
+#if   MAKEFILE_MOUSE_ACCEL_CURVE == 1
+	#define  CURVE(x)  (x)
+#elif MAKEFILE_MOUSE_ACCEL_CURVE == 2
+	#define  CURVE(x)  ((x)*(x))
+#elif MAKEFILE_MOUSE_ACCEL_CURVE == 3
+	#define  CURVE(x)  ((x)*(x)*(x))
+#else
+	#error "MOUSE_ACCEL_CURVE must be 1, 2, or 3"
+#endif
+
+#define  SPEED(i)  ( (uint32_t)( ( MAKEFILE_MOUSE_SPEED_MIN			\
+				   + ( MAKEFILE_MOUSE_SPEED_MAX		\
+				       - MAKEFILE_MOUSE_SPEED_MIN )		\
+				     * CURVE( (double)(i) / SEGMENTS ) )	\
+				 * 65536.0 / 1000 ) )
+#define  STEP(i)   ( (SPEED((i)+1) - SPEED(i)) / SEGMENT_FRAMES )
+
+#define  FOUR(f, i)  f(i), f((i)+1), f((i)+2), f((i)+3)
+
+static const uint32_t PROGMEM _speed[SEGMENTS+1] = {
+	FOUR(SPEED, 0), FOUR(SPEED, 4), FOUR(SPEED, 8), FOUR(SPEED, 12),
+	SPEED(SEGMENTS) };
+static const uint32_t PROGMEM _step[SEGMENTS] = {
+	FOUR(STEP, 0), FOUR(STEP, 4), FOUR(STEP, 8), FOUR(STEP, 12) };
+
+// the wheel turns at a constant `MOUSE_WHEEL_SPEED` (detents per second)
+#define  WHEEL_STEP  ( (uint32_t)MAKEFILE_MOUSE_WHEEL_SPEED * 65536 / 1000 )
+
+// ----------------------------------------------------------------------------
+
+#define  POINTER  (MOUSEKEYS_UP|MOUSEKEYS_DOWN|MOUSEKEYS_LEFT|MOUSEKEYS_RIGHT)
+#define  WHEEL    (MOUSEKEYS_WHEEL_UP|MOUSEKEYS_WHEEL_DOWN)
+
+static volatile uint8_t _held;  // directions currently held
+
+static uint32_t _pointer_speed;     // see `_speed`
+static uint8_t  _pointer_segment;   // curve segment (`SEGMENTS` = at max)
+static uint16_t _pointer_frames;    // frames into the current segment
+static uint16_t _pointer_fraction;  // pixels moved, but not yet sent
+static uint16_t _wheel_fraction;    // detents turned, but not yet sent
+
+// ----------------------------------------------------------------------------
+
+// add 'd' to 'v', saturating well within the range of an `int16_t` (in case
+// the host stops reading reports)
+static void _add(int16_t * v, int8_t d) {
+	if ((d > 0 && *v < 0x3FFF) || (d < 0 && *v > -0x3FFF))
+		*v += d;
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Start or stop moving in the given direction(s)
+ *
+ * Arguments
+ * - 'press': whether the direction keys are being pressed (true) or released
+ *   (false)
+ * - 'directions': any of `MOUSEKEYS_...`, or'ed together
+ */
+void mousekeys_move(bool press, uint8_t directions) {
+	if (press) _held |=  directions;
+	else       _held &= ~directions;
+}
+
+/*
+ * Move the pointer and wheel by one frame's worth
+ *
+ * Notes
+ * - Must be called once per USB frame (1 ms), with interrupts disabled
+ * - Motion goes into `mouse_x`, `mouse_y`, and `mouse_wheel`, for the USB
+ *   code to send
+ * - The first frame a direction is held always moves at least 1 pixel (or
+ *   detent), so that a quick tap does something
+ */
+void mousekeys_frame(void) {
+	uint8_t held = _held;
+
+	if (held & POINTER) {
+		uint32_t speed = _pointer_speed;
+		// diagonals: scale by ~1/sqrt(2), so the speed along the path stays
+		// the same
+		if ( (held & (MOUSEKEYS_UP|MOUSEKEYS_DOWN))
+		  && (held & (MOUSEKEYS_LEFT|MOUSEKEYS_RIGHT)) )
+			speed = (speed >> 8) * 181;
+
+		uint32_t position = _pointer_fraction + speed;
+		int8_t   d        = position >> 16;
+		_pointer_fraction = position;
+
+		if (held & MOUSEKEYS_UP)    _add(&mouse_y, -d);
+		if (held & MOUSEKEYS_DOWN)  _add(&mouse_y,  d);
+		if (held & MOUSEKEYS_LEFT)  _add(&mouse_x, -d);
+		if (held & MOUSEKEYS_RIGHT) _add(&mouse_x,  d);
+
+		if (_pointer_segment < SEGMENTS) {
+			_pointer_speed += pgm_read_dword(&_step[_pointer_segment]);
+			if (++_pointer_frames == SEGMENT_FRAMES) {
+				_pointer_frames = 0;
+				_pointer_segment++;
+				_pointer_speed =
+					pgm_read_dword(&_speed[_pointer_segment]);
+			}
+		}
+	} else {
+		_pointer_speed    = pgm_read_dword(&_speed[0]);
+		_pointer_segment  = 0;
+		_pointer_frames   = 0;
+		_pointer_fraction = 0xFFFF;
+	}
+
+	if (held & WHEEL) {
+		uint32_t position = _wheel_fraction + WHEEL_STEP;
+		int8_t   d        = position >> 16;
+		_wheel_fraction = position;
+
+		if (held & MOUSEKEYS_WHEEL_UP)   _add(&mouse_wheel,  d);
+		if (held & MOUSEKEYS_WHEEL_DOWN) _add(&mouse_wheel, -d);
+	} else {
+		_wheel_fraction = 0xFFFF;
+	}
+}
+
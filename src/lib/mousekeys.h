@@ -0,0 +1,32 @@
+/* ----------------------------------------------------------------------------
+ * Mouse keys (pointer and wheel motion) : exports
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2026 The ergodox-firmware contributors
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#ifndef LIB__MOUSEKEYS_h
+	#define LIB__MOUSEKEYS_h
+
+	#include <stdbool.h>
+	#include <stdint.h>
+
+	// --------------------------------------------------------------------
+
+	// directions, for `mousekeys_move()`
+	#define  MOUSEKEYS_UP          (1<<0)
+	#define  MOUSEKEYS_DOWN        (1<<1)
+	#define  MOUSEKEYS_LEFT        (1<<2)
+	#define  MOUSEKEYS_RIGHT       (1<<3)
+	#define  MOUSEKEYS_WHEEL_UP    (1<<4)
+	#define  MOUSEKEYS_WHEEL_DOWN  (1<<5)
+
+	// --------------------------------------------------------------------
+
+	void mousekeys_move  (bool press, uint8_t directions);
+	void mousekeys_frame (void);
+
+#endif
+
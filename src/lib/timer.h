@@ -0,0 +1,16 @@
+/* ----------------------------------------------------------------------------
+ * Timer (fixed rate tick) : exports
+ *
+ * Code specific to different development boards is used by modifying a
+ * variable in the makefile.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2026 The ergodox-firmware contributors
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include "../lib/variable-include.h"
+#define INCLUDE EXP_STR( ./timer/MAKEFILE_BOARD.h )
+#include INCLUDE
+
@@ -0,0 +1,228 @@
+/* ----------------------------------------------------------------------------
+ * Very simple Teensy 2.0 timer library : code
+ *
+ * - Uses Timer3 (16-bit) in CTC mode (datasheet section 14.9.2), with a
+ *   prescaler of 8, to generate a fixed rate tick.  Timer1 is used for the
+ *   LED PWM, and Timer0 is left alone.
+ * - At 16 MHz the counter runs at 2 MHz, so any frequency from ~31 Hz up
+ *   can be generated, and `TCNT3` doubles as a 0.5 us resolution timestamp
+ *   relative to the last tick.
+ * - The tick can be phase locked to an outside event of the same frequency
+ *   (see `timer_sync()`), by stretching or shrinking single periods.
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2026 The ergodox-firmware contributors
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+// ----------------------------------------------------------------------------
+// conditional compile
+#if MAKEFILE_BOARD == teensy-2-0
+// ----------------------------------------------------------------------------
+
+
+#include <stdint.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <avr/wdt.h>
+#include "./teensy-2-0.h"
+
+// ----------------------------------------------------------------------------
+
+static volatile uint16_t _ticks;    // free running tick count
+static volatile uint8_t  _pending;  // ticks not yet consumed by a waiter
+
+static volatile uint16_t _top;         // `OCR3A`, for a normal period
+static volatile int16_t  _adjust;      // added to the next period, once
+static volatile uint16_t _sync_lead;   // see `timer_sync()`; 0 = off
+static volatile int16_t  _sync_error;  // the last phase error measured
+
+// ----------------------------------------------------------------------------
+
+ISR(TIMER3_COMPA_vect) {
+	// set the length of the period that just started (`TCNT3` is still
+	// near 0, and `_adjust` is at most a quarter period, so this is safe)
+	OCR3A = _top + _adjust;
+	_adjust = 0;
+
+	_ticks++;
+	if (_pending < 0xFF)
+		_pending++;
+}
+
+// only here to wake the CPU (see `timer_sleep_long()`)
+ISR(WDT_vect) {}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Arguments
+ * - 'frequency': the tick rate, in Hz
+ */
+void timer_init(uint16_t frequency) {
+	// CTC mode (TOP = OCR3A), prescaler = 8
+	TCCR3A = 0;
+	TCCR3B = (1<<WGM32)|(1<<CS31);
+	timer_set_frequency(frequency);
+	// enable the compare match interrupt
+	TIMSK3 = (1<<OCIE3A);
+
+	// sleeping in idle mode stops only the CPU; timers and USB keep running
+	set_sleep_mode(SLEEP_MODE_IDLE);
+}
+
+void timer_set_frequency(uint16_t frequency) {
+	uint8_t sreg = SREG;
+	cli();
+	_top = (uint16_t)(F_CPU / 8 / frequency) - 1;
+	_adjust = 0;
+	_sync_lead = 0;  // the old lead means nothing at the new frequency
+	OCR3A = _top;
+	TCNT3 = 0;
+	SREG = sreg;
+}
+
+/*
+ * Sleep until the next tick (or return immediately, if one is pending)
+ *
+ * Returns
+ * - the number of ticks that have occurred since the last call: 1 normally,
+ *   more if the caller took longer than one tick period to get back here
+ */
+uint8_t timer_wait_tick(void) {
+	uint8_t ticks;
+
+	cli();
+	while (!_pending) {
+		// `sei` takes effect after the next instruction, so no interrupt can
+		// slip in between enabling interrupts and going to sleep
+		sleep_enable();
+		sei();
+		sleep_cpu();
+		sleep_disable();
+		cli();
+	}
+	ticks = _pending;
+	_pending = 0;
+	sei();
+
+	return ticks;
+}
+
+/*
+ * Sleep, in power-down mode, for about 32 ms (or until some other interrupt
+ * that can wake the CPU from power-down, like a USB wakeup)
+ *
+ * Notes
+ * - For while the USB bus is suspended, when even idle mode draws too much
+ * - Timer3 stops while we're asleep, so ticks aren't counted; the watchdog
+ *   (in interrupt mode, not reset mode) does the waking instead
+ */
+void timer_sleep_long(void) {
+	cli();
+	wdt_reset();
+	// timed sequence (datasheet section 10.9.2): interrupt only, ~32 ms
+	WDTCSR = (1<<WDCE)|(1<<WDE);
+	WDTCSR = (1<<WDIE)|(1<<WDP0);
+
+	set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+	sleep_enable();
+	sei();
+	sleep_cpu();
+	sleep_disable();
+	set_sleep_mode(SLEEP_MODE_IDLE);
+
+	cli();
+	wdt_reset();
+	MCUSR &= ~(1<<WDRF);
+	WDTCSR = (1<<WDCE)|(1<<WDE);
+	WDTCSR = 0;
+	sei();
+}
+
+uint16_t timer_get_ticks(void) {
+	uint16_t ticks;
+	uint8_t sreg = SREG;
+	cli();
+	ticks = _ticks;
+	SREG = sreg;
+	return ticks;
+}
+
+/*
+ * Returns
+ * - the time since the last tick, in units of 1/`TIMER_SUBTICKS_PER_US` us
+ */
+uint16_t timer_get_subticks(void) {
+	uint16_t subticks;
+	uint8_t sreg = SREG;
+	cli();
+	subticks = TCNT3;
+	SREG = sreg;
+	return subticks;
+}
+
+/*
+ * Phase lock the tick to an outside event (e.g. the USB start of frame)
+ *
+ * Arguments
+ * - 'lead': how long before the event the tick should be, in subticks; 0
+ *   turns syncing off.  Clamped to less than one period.  Changing the
+ *   frequency turns syncing off too.
+ *
+ * Notes
+ * - `timer_sync_event()` must then be called (from an ISR, or with
+ *   interrupts disabled) each time the event happens.  The event must
+ *   happen once per tick, so the phase error is always well defined.
+ * - Each event measures the phase error (`TCNT3` at the event, minus
+ *   'lead', wrapped into +/- half a period), and a quarter of it is
+ *   added to the next period.  The correction shows up one event late, so
+ *   a gain of 1/4 is what gives the quickest convergence without
+ *   overshoot; it also takes care of the drift between the two clocks.
+ * - Periods must fit in an `int16_t` (frequencies above ~62 Hz)
+ */
+void timer_sync(uint16_t lead) {
+	uint8_t sreg = SREG;
+	cli();
+	if (lead > _top)
+		lead = _top;
+	_sync_lead = lead;
+	SREG = sreg;
+}
+
+void timer_sync_event(void) {
+	if (!_sync_lead)
+		return;
+
+	int16_t period = _top + 1;
+	int16_t error  = (int16_t)TCNT3 - (int16_t)_sync_lead;
+	if (error > period/2)
+		error -= period;
+	else if (error < -period/2)
+		error += period;
+
+	_sync_error = error;
+	_adjust = error / 4;
+}
+
+/*
+ * Returns
+ * - the phase error at the last sync event, in subticks (positive: the
+ *   event came later than wanted)
+ */
+int16_t timer_get_sync_error(void) {
+	int16_t error;
+	uint8_t sreg = SREG;
+	cli();
+	error = _sync_error;
+	SREG = sreg;
+	return error;
+}
+
+
+// ----------------------------------------------------------------------------
+#endif
+// ----------------------------------------------------------------------------
+
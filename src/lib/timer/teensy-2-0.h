@@ -0,0 +1,34 @@
+/* ----------------------------------------------------------------------------
+ * Very simple Teensy 2.0 timer library : exports
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2026 The ergodox-firmware contributors
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#ifndef TIMER_h
+	#define TIMER_h
+
+	#include <stdint.h>
+
+	// --------------------------------------------------------------------
+
+	// the sub-tick counter runs at F_CPU/8 (2 MHz at 16 MHz)
+	#define TIMER_SUBTICKS_PER_US  (F_CPU / 8 / 1000000)
+
+	// --------------------------------------------------------------------
+
+	void     timer_init           (uint16_t frequency);
+	void     timer_set_frequency  (uint16_t frequency);
+	uint8_t  timer_wait_tick      (void);
+	void     timer_sleep_long     (void);
+	uint16_t timer_get_ticks      (void);
+	uint16_t timer_get_subticks   (void);
+
+	void     timer_sync           (uint16_t lead);
+	void     timer_sync_event     (void);
+	int16_t  timer_get_sync_error (void);
+
+#endif
+
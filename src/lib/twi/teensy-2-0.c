@@ -6,6 +6,13 @@
  * - Also see the documentation for `<util/twi.h>` at
  *   <http://www.nongnu.org/avr-libc/user-manual/group__util__twi.html#ga8d3aca0acc182f459a51797321728168>
  *
+ * - Transfers can also be queued (`twi_queue()`), to run in the background
+ *   from `TWI_vect`; the synchronous functions (`twi_start()` etc.) wait for
+ *   the queue to empty, then poll `TWINT` as before, with the interrupt off
+ * - Every wait is bounded (see `TWI_TIMEOUT_US`).  On a timeout the bus is
+ *   recovered (see `twi_recover()`), so a bad cable or a stuck slave can
+ *   only ever cost a known amount of time.
+ *
  * Some other (more complete) TWI libraries for the Teensy 2.0 (and other Atmel
  * processors):
  * - [i2cmaster] (http://homepage.hispeed.ch/peterfleury/i2cmaster.zip)
@@ -27,11 +34,311 @@
 // ----------------------------------------------------------------------------
 
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/delay.h>
 #include <util/twi.h>
 #include "./teensy-2-0.h"
 
 // ----------------------------------------------------------------------------
 
+// `TWCR` values, for the ISR
+#define  TWCR_NEXT        ( (1<<TWINT)|(1<<TWEN)|(1<<TWIE) )
+#define  TWCR_ACK         ( TWCR_NEXT|(1<<TWEA) )
+#define  TWCR_START       ( TWCR_NEXT|(1<<TWSTA) )
+#define  TWCR_STOP_START  ( TWCR_NEXT|(1<<TWSTO)|(1<<TWSTA) )
+#define  TWCR_STOP        ( (1<<TWINT)|(1<<TWEN)|(1<<TWSTO) )
+
+// ----------------------------------------------------------------------------
+
+// spins of `_wait_until()`, for `TWI_TIMEOUT_US`
+// - each spin is at least 6 cycles (a load, a bit test, a 16-bit decrement,
+//   and a branch), and not much more than 8, so the real timeout is between
+//   `TWI_TIMEOUT_US` and about 4/3 of it
+#define  TIMEOUT_SPINS  ( (uint32_t)TWI_TIMEOUT_US * (F_CPU / 1000000) / 6 )
+
+/*
+ * Spin until `condition` is true, or `TIMEOUT_SPINS` run out
+ *
+ * Evaluates to
+ * - whether `condition` became true (i.e. false on a timeout)
+ */
+#define  _wait_until(condition)  ({		\
+		uint16_t _spins = TIMEOUT_SPINS;	\
+		while (!(condition) && --_spins);	\
+		(bool) _spins; })
+
+// bus pins (when the TWI is disabled, for `twi_recover()`)
+#define  SCL_BIT  0  // PD0
+#define  SDA_BIT  1  // PD1
+
+// ----------------------------------------------------------------------------
+
+// the queue; `_head` is the transfer on the wire
+static struct twi_xfer * volatile _head;
+static struct twi_xfer *          _tail;
+
+static uint8_t _index;    // next byte of the current buffer
+static bool    _reading;  // whether we're in the read part of `_head`
+
+static volatile uint8_t _events;  // bumped on each interrupt; see `twi_wait()`
+
+// may be read at any time; saturate at 0xFFFF
+struct twi_errors twi_errors;
+
+// ----------------------------------------------------------------------------
+
+static void _count(uint16_t * counter) {
+	if (*counter < 0xFFFF)
+		(*counter)++;
+}
+
+// count an error status, and pass it on
+static uint8_t _error(uint8_t status) {
+	switch (status) {
+		case TW_MT_SLA_NACK:
+		case TW_MR_SLA_NACK:
+			_count(&twi_errors.sla_nack);
+			break;
+		case TW_MT_DATA_NACK:
+			_count(&twi_errors.data_nack);
+			break;
+		case TW_MT_ARB_LOST:  // (== TW_MR_ARB_LOST)
+			_count(&twi_errors.arbitration);
+			break;
+		default:
+			_count(&twi_errors.other);
+			break;
+	}
+	return status;
+}
+
+// count a timeout, recover the bus, and return the status to pass on
+static uint8_t _timeout(void) {
+	_count(&twi_errors.timeout);
+	twi_recover();
+	return TWI_TIMEOUT;
+}
+
+// ----------------------------------------------------------------------------
+
+// set up to run `_head` (from its start)
+static void _begin(void) {
+	_index   = 0;
+	_reading = !_head->write_len && _head->read_len;
+}
+
+/*
+ * Finish `_head`, and start the next transfer (if any)
+ *
+ * Notes
+ * - Send a stop if there was an error (so the next transfer always starts
+ *   clean) or if `_head` didn't ask to keep the bus
+ * - With no next transfer and `TWI_NO_STOP`, the interrupt is turned off and
+ *   `TWINT` is left set, which holds SCL low until someone continues
+ */
+static void _finish(uint8_t status) {
+	struct twi_xfer * xfer = _head;
+	bool hold = !status && (xfer->flags & TWI_NO_STOP);
+
+	xfer->status = status;
+	if (xfer->callback)
+		xfer->callback(xfer);  // while it's still `_head`; see `twi_queue()`
+
+	_head = xfer->next;
+	if (_head) {
+		_begin();
+		TWCR = hold ? TWCR_START : TWCR_STOP_START;
+	} else {
+		TWCR = hold ? (1<<TWEN) : TWCR_STOP;
+	}
+}
+
+ISR(TWI_vect) {
+	struct twi_xfer * xfer = _head;
+
+	_events++;
+
+	switch (TW_STATUS) {
+		case TW_START:
+		case TW_REP_START:
+			_index = 0;
+			TWDR = (xfer->address<<1) | (_reading ? TW_READ : TW_WRITE);
+			TWCR = TWCR_NEXT;
+			break;
+
+		case TW_MT_SLA_ACK:
+		case TW_MT_DATA_ACK:
+			if (_index < xfer->write_len) {
+				TWDR = xfer->write[_index++];
+				TWCR = TWCR_NEXT;
+			} else if (xfer->read_len) {
+				_reading = true;
+				TWCR = TWCR_START;
+			} else {
+				_finish(0);
+			}
+			break;
+
+		case TW_MR_DATA_ACK:
+			xfer->read[_index++] = TWDR;
+			// fall through
+		case TW_MR_SLA_ACK:
+			// ACK every byte but the last
+			TWCR = (_index+1 < xfer->read_len) ? TWCR_ACK : TWCR_NEXT;
+			break;
+
+		case TW_MR_DATA_NACK:
+			xfer->read[_index++] = TWDR;
+			_finish(0);
+			break;
+
+		default:  // error
+			_finish(_error(TW_STATUS));
+			break;
+	}
+}
+
+// ----------------------------------------------------------------------------
+
+// wait until the queue is empty, and any stop has been sent
+static void _wait_idle(void) {
+	if (_head)
+		twi_wait(_tail);
+	if (!_wait_until( !(TWCR & (1<<TWSTO)) ))
+		_timeout();
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Add a transfer to the queue, starting it if the bus is free
+ *
+ * Notes
+ * - May be called from a completion callback (in which case the transfer
+ *   calling back is still `_head`, so this only ever appends)
+ */
+void twi_queue(struct twi_xfer * xfer) {
+	xfer->status = TWI_PENDING;
+	xfer->next   = NULL;
+
+	uint8_t sreg = SREG;
+	cli();
+	if (_head) {
+		_tail->next = xfer;
+		_tail = xfer;
+	} else {
+		if (!_wait_until( !(TWCR & (1<<TWSTO)) )) {
+			SREG = sreg;
+			xfer->status = _timeout();
+			return;
+		}
+		_head = _tail = xfer;
+		_begin();
+		TWCR = TWCR_START;  // (a repeated start, if the bus is being held)
+	}
+	SREG = sreg;
+}
+
+/*
+ * Queue a transfer, and wait for it to complete
+ *
+ * Returns
+ * - success: 0
+ * - failure: twi status code
+ */
+uint8_t twi_transfer(struct twi_xfer * xfer) {
+	twi_queue(xfer);
+	return twi_wait(xfer);
+}
+
+/*
+ * Wait for a queued transfer to complete
+ *
+ * Returns
+ * - success: 0
+ * - failure: twi status code (or `TWI_TIMEOUT`)
+ *
+ * Notes
+ * - Times out if the bus makes no progress (no interrupt) for
+ *   `TWI_TIMEOUT_US`; the bus is then recovered, and everything queued
+ *   fails with `TWI_TIMEOUT`.  The worst case is therefore
+ *   (events left in the queue + 1) * `TWI_TIMEOUT_US`, plus the recovery.
+ */
+uint8_t twi_wait(struct twi_xfer * xfer) {
+	while (xfer->status == TWI_PENDING) {
+		uint8_t events = _events;
+		if (!_wait_until( events != _events ||
+				  xfer->status != TWI_PENDING )) {
+			_timeout();
+			break;
+		}
+	}
+	return xfer->status;
+}
+
+// whether there are transfers queued (or on the wire)
+bool twi_busy(void) {
+	return _head;
+}
+
+/*
+ * Reset the TWI, and free the bus
+ *
+ * Notes
+ * - Everything queued fails with `TWI_TIMEOUT` (callbacks are not called)
+ * - A slave that was sending when things went wrong may be holding SDA low,
+ *   waiting for the rest of its clocks.  With the TWI disabled, we clock SCL
+ *   by hand (up to 9 times, for a whole byte and its ACK) until SDA is
+ *   released, then send a stop.
+ * - SCL and SDA have external pull-ups; we only ever drive them low, and
+ *   "release" them by making them inputs (without the internal pull-up)
+ * - Takes about 100us, at most
+ */
+void twi_recover(void) {
+	uint8_t sreg = SREG;
+	cli();
+	TWCR = 0;  // disable the TWI (and its interrupt)
+	for (struct twi_xfer * xfer = _head; xfer; xfer = xfer->next)
+		xfer->status = TWI_TIMEOUT;
+	_head = NULL;
+	SREG = sreg;
+
+	_count(&twi_errors.recovered);
+
+	#define  _release(bit)  (DDRD &= ~(1<<(bit)))
+	#define  _drive(bit)    (DDRD |=  (1<<(bit)))
+	#define  _high(bit)     (PIND & (1<<(bit)))
+
+	PORTD &= ~( (1<<SCL_BIT)|(1<<SDA_BIT) );
+	_release(SDA_BIT);
+	_release(SCL_BIT);
+	_delay_us(5);
+
+	for (uint8_t i=0; i<9 && !_high(SDA_BIT); i++) {
+		_drive(SCL_BIT);   _delay_us(5);
+		_release(SCL_BIT); _delay_us(5);
+	}
+
+	// stop: SDA low -> high, while SCL is high
+	_drive(SCL_BIT);   _delay_us(5);
+	_drive(SDA_BIT);   _delay_us(5);
+	_release(SCL_BIT); _delay_us(5);
+	_release(SDA_BIT); _delay_us(5);
+
+	#undef  _release
+	#undef  _drive
+	#undef  _high
+
+	twi_init();
+	TWCR = (1<<TWEN);
+}
+
+// ----------------------------------------------------------------------------
+
 void twi_init(void) {
 	// set the prescaler value to 0
 	TWSR &= ~( (1<<TWPS1)|(1<<TWPS0) );
@@ -42,49 +349,80 @@ void twi_init(void) {
 }
 
 uint8_t twi_start(void) {
+	_wait_idle();
 	// send start
 	TWCR = (1<<TWINT)|(1<<TWEN)|(1<<TWSTA);
 	// wait for transmission to complete
-	while (!(TWCR & (1<<TWINT)));
+	if (!_wait_until( TWCR & (1<<TWINT) ))
+		return _timeout();
 	// if it didn't work, return the status code (else return 0)
 	if ( (TW_STATUS != TW_START) &&
 	     (TW_STATUS != TW_REP_START) )
-		return TW_STATUS;  // error
+		return _error(TW_STATUS);
 	return 0;  // success
 }
 
 void twi_stop(void) {
+	_wait_idle();
 	// send stop
 	TWCR = (1<<TWINT)|(1<<TWEN)|(1<<TWSTO);
 	// wait for transmission to complete
-	while (TWCR & (1<<TWSTO));
+	if (!_wait_until( !(TWCR & (1<<TWSTO)) ))
+		_timeout();
 }
 
 uint8_t twi_send(uint8_t data) {
+	_wait_idle();
 	// load data into the data register
 	TWDR = data;
 	// send data
 	TWCR = (1<<TWINT)|(1<<TWEN);
 	// wait for transmission to complete
-	while (!(TWCR & (1<<TWINT)));
+	if (!_wait_until( TWCR & (1<<TWINT) ))
+		return _timeout();
 	// if it didn't work, return the status code (else return 0)
 	if ( (TW_STATUS != TW_MT_SLA_ACK)  &&
 	     (TW_STATUS != TW_MT_DATA_ACK) &&
 	     (TW_STATUS != TW_MR_SLA_ACK) )
-		return TW_STATUS;  // error
+		return _error(TW_STATUS);
 	return 0;  // success
 }
 
 uint8_t twi_read(uint8_t * data) {
+	_wait_idle();
 	// read 1 byte to TWDR, send ACK
 	TWCR = (1<<TWINT)|(1<<TWEN)|(1<<TWEA);
 	// wait for transmission to complete
-	while (!(TWCR & (1<<TWINT)));
+	if (!_wait_until( TWCR & (1<<TWINT) ))
+		return _timeout();
 	// set data variable
 	*data = TWDR;
 	// if it didn't work, return the status code (else return 0)
 	if (TW_STATUS != TW_MR_DATA_ACK)
-		return TW_STATUS;  // error
+		return _error(TW_STATUS);
+	return 0;  // success
+}
+
+/*
+ * Read the last byte of a read (before a stop or repeated start)
+ *
+ * Notes
+ * - The master must NACK the final byte, or the slave will go on to drive
+ *   the first bit of the next one, and may hold SDA low through the
+ *   following stop or repeated start
+ */
+uint8_t twi_read_nack(uint8_t * data) {
+	_wait_idle();
+	// read 1 byte to TWDR, send NACK
+	TWCR = (1<<TWINT)|(1<<TWEN);
+	// wait for transmission to complete
+	if (!_wait_until( TWCR & (1<<TWINT) ))
+		return _timeout();
+	// set data variable
+	*data = TWDR;
+	// if it didn't work, return the status code (else return 0)
+	if (TW_STATUS != TW_MR_DATA_NACK)
+		return _error(TW_STATUS);
 	return 0;  // success
 }
 
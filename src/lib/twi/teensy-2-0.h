@@ -10,19 +10,90 @@
 #ifndef TWI_h
 	#define TWI_h
 
+	#include <stdbool.h>
+	#include <stdint.h>
+
 	// --------------------------------------------------------------------
 
 	#ifndef TWI_FREQ
-		#define TWI_FREQ 100000  // in Hz
+		#ifdef MAKEFILE_TWI_FREQ
+			#define TWI_FREQ MAKEFILE_TWI_FREQ
+		#else
+			#define TWI_FREQ 100000  // in Hz
+		#endif
+	#endif
+
+	// how long to wait for the bus to make progress, before giving up
+	// - in us; 4 byte times (90us at 400kHz)
+	#ifndef TWI_TIMEOUT_US
+		#define TWI_TIMEOUT_US  ( 4UL * 9 * 1000000 / TWI_FREQ )
 	#endif
 
 	// --------------------------------------------------------------------
 
-	void    twi_init  (void);
-	uint8_t twi_start (void);
-	void    twi_stop  (void);
-	uint8_t twi_send  (uint8_t data);
-	uint8_t twi_read  (uint8_t * data);
+	// status for a wait that timed out (after which the bus was recovered)
+	// - twi status codes always have their low 3 bits clear, so this can't
+	//   be one
+	#define TWI_TIMEOUT  0x01
+
+	// `twi_xfer.status`, while the transfer is queued or on the wire
+	// - 0 means success, and anything else is a twi status code; status
+	//   codes always have their low 3 bits clear, so this can't be one
+	#define TWI_PENDING  0xFF
+
+	// `twi_xfer.flags`
+	// - NO_STOP: end with a repeated start into the next transfer, instead
+	//   of a stop (if there's no next transfer yet, the bus is held until
+	//   there is, or until the synchronous functions take it over)
+	#define TWI_NO_STOP  (1<<0)
+
+	/*
+	 * A queued transfer: write `write_len` bytes, then (after a repeated
+	 * start) read `read_len` bytes, to/from the slave at `address` (7 bit)
+	 * - either length may be 0 (both 0 just checks for an ACK)
+	 * - `callback` (if not NULL) is called from the ISR on completion, and
+	 *   may queue further transfers (but not one still in the queue)
+	 * - nothing here may be changed until `status` is no longer
+	 *   `TWI_PENDING`
+	 */
+	struct twi_xfer {
+		uint8_t address;
+		const uint8_t * write;
+		uint8_t write_len;
+		uint8_t * read;
+		uint8_t read_len;
+		uint8_t flags;
+		volatile uint8_t status;
+		void (*callback)(struct twi_xfer * xfer);
+		struct twi_xfer * next;  // private
+	};
+
+	// error counts, by type (saturating)
+	struct twi_errors {
+		uint16_t timeout;      // a wait timed out
+		uint16_t recovered;    // `twi_recover()` was run
+		uint16_t sla_nack;     // an address wasn't ACKed (nothing there?)
+		uint16_t data_nack;    // a data byte wasn't ACKed
+		uint16_t arbitration;  // arbitration lost (noise, with one master)
+		uint16_t other;        // any other unexpected status
+	};
+
+	extern struct twi_errors twi_errors;
+
+	// --------------------------------------------------------------------
+
+	void    twi_queue     (struct twi_xfer * xfer);
+	uint8_t twi_transfer  (struct twi_xfer * xfer);
+	uint8_t twi_wait      (struct twi_xfer * xfer);
+	bool    twi_busy      (void);
+	void    twi_recover   (void);
+
+	void    twi_init      (void);
+	uint8_t twi_start     (void);
+	void    twi_stop      (void);
+	uint8_t twi_send      (uint8_t data);
+	uint8_t twi_read      (uint8_t * data);
+	uint8_t twi_read_nack (uint8_t * data);
 
 #endif
 
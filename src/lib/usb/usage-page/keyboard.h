@@ -269,10 +269,45 @@
 //     (Reserved)           0xE8..0xFFFF  // -  -   -     -
 
 // Media key codes are not real scan codes, they must be translated to a 16
-//  bit number by the consumer key key function
+//  bit number by the consumer key key function (they're indices into its
+//  table; a layout may supply its own table, of any consumer usages, instead;
+//  see "lib/key-functions/private.c")
 #define MEDIAKEY_PLAY_PAUSE    0x00
 #define MEDIAKEY_PREV_TRACK    0x01
 #define MEDIAKEY_NEXT_TRACK    0x02
+#define MEDIAKEY_STOP          0x03
+#define MEDIAKEY_MUTE          0x04
+#define MEDIAKEY_VOLUME_UP     0x05
+#define MEDIAKEY_VOLUME_DOWN   0x06
+#define MEDIAKEY_EJECT         0x07
+#define MEDIAKEY_EMAIL         0x08
+#define MEDIAKEY_CALCULATOR    0x09
+#define MEDIAKEY_MY_COMPUTER   0x0A
+#define MEDIAKEY_WWW_SEARCH    0x0B
+#define MEDIAKEY_WWW_HOME      0x0C
+#define MEDIAKEY_WWW_BACK      0x0D
+#define MEDIAKEY_WWW_FORWARD   0x0E
+#define MEDIAKEY_WWW_STOP      0x0F
+#define MEDIAKEY_WWW_REFRESH   0x10
+#define MEDIAKEY_WWW_FAVORITES 0x11
+
+// System control key codes are the real usages (Generic Desktop page), for
+//  the system control key function; see `SYSTEM_...` in
+//  "lib-other/pjrc/usb_keyboard/usb_keyboard.h"
+
+// Mouse key codes are not real scan codes either; they're for the mouse key
+//  key function
+#define MOUSEKEY_BUTTON_1      0x00
+#define MOUSEKEY_BUTTON_2      0x01
+#define MOUSEKEY_BUTTON_3      0x02
+#define MOUSEKEY_BUTTON_4      0x03
+#define MOUSEKEY_BUTTON_5      0x04
+#define MOUSEKEY_UP            0x08
+#define MOUSEKEY_DOWN          0x09
+#define MOUSEKEY_LEFT          0x0A
+#define MOUSEKEY_RIGHT         0x0B
+#define MOUSEKEY_WHEEL_UP      0x0C
+#define MOUSEKEY_WHEEL_DOWN    0x0D
 
 // ----------------------------------------------------------------------------
 // ----------------------------------------------------------------------------
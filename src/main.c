@@ -13,24 +13,52 @@
 #include <util/delay.h>
 #include "./lib-other/pjrc/usb_keyboard/usb_keyboard.h"
 #include "./lib/key-functions/public.h"
+#include "./lib/debounce.h"
+#include "./lib/timer.h"
 #include "./keyboard/controller.h"
 #include "./keyboard/layout.h"
 #include "./keyboard/matrix.h"
 #include "./main.h"
+#include "./telemetry.h"
 
 // ----------------------------------------------------------------------------
 
 #define  MAX_ACTIVE_LAYERS  20
 
+// scans with no keys down before going idle (see "makefile-options")
+#define  IDLE_TICKS  ( (uint32_t)MAKEFILE_IDLE_TIMEOUT * MAKEFILE_SCAN_RATE / 1000 )
+
+// whether to phase lock scans to the USB frame, and how long before the start
+// of the frame they're locked to they should finish (in timer subticks); only
+// possible with a whole number of frames per scan (see "makefile-options")
+#define  SOF_SYNC  ( MAKEFILE_SOF_SYNC_MARGIN && usb_frames_per_sync )
+#define  SOF_SYNC_MARGIN  \
+	( (uint16_t)MAKEFILE_SOF_SYNC_MARGIN * TIMER_SUBTICKS_PER_US )
+
+// whether to send reports after every key event, instead of once per scan
+// (see "makefile-options")
+#define  REPORT_PER_EVENT  MAKEFILE_REPORT_PER_EVENT
+
+// the most reports one key event can queue (on any one queue): the one sent
+// after it, plus two of its own (e.g. `kbfun_2_keys_capslock_press_release()`)
+#define  REPORT_ROOM  3
+
 // ----------------------------------------------------------------------------
-static bool _main_kb_is_pressed[KB_ROWS][KB_COLUMNS];
-bool (*main_kb_is_pressed)[KB_ROWS][KB_COLUMNS] = &_main_kb_is_pressed;
+// one bitmap per row (see "keyboard/matrix.h")
+static uint16_t main_kb_raw[KB_ROWS];
+
+static uint16_t _main_kb_is_pressed[KB_ROWS];
+uint16_t (*main_kb_is_pressed)[KB_ROWS] = &_main_kb_is_pressed;
 
-static bool _main_kb_was_pressed[KB_ROWS][KB_COLUMNS];
-bool (*main_kb_was_pressed)[KB_ROWS][KB_COLUMNS] = &_main_kb_was_pressed;
+static uint16_t _main_kb_was_pressed[KB_ROWS];
+uint16_t (*main_kb_was_pressed)[KB_ROWS] = &_main_kb_was_pressed;
 
 static bool main_kb_was_transparent[KB_ROWS][KB_COLUMNS];
 
+// whether there are key events waiting for room in the report queues (see
+// `main_kb_event()`)
+static bool main_kb_pending;
+
 uint8_t main_layers_pressed[KB_ROWS][KB_COLUMNS];
 
 uint8_t main_loop_row;
@@ -45,6 +73,154 @@ bool    main_arg_was_pressed;
 bool    main_arg_any_non_trans_key_pressed;
 bool    main_arg_trans_key_pressed;
 
+uint16_t main_scan_rate = MAKEFILE_SCAN_RATE;
+uint16_t main_scan_duration;
+uint16_t main_scan_duration_max;
+uint16_t main_scan_ticks_missed;
+
+bool     main_idle;
+uint16_t main_idle_wake_duration;
+uint16_t main_idle_wake_duration_max;
+static uint32_t main_idle_ticks;  // scans in a row with no keys down
+
+static uint16_t main_sync_lead;  // recent slowest scan (see `main()`)
+static uint16_t main_sync_rate;  // the scan rate it was measured at
+
+// (see "Layer Functions", below)
+static void             main_layers_resolve_all   (void);
+static void_funptr_t    main_layers_resolve       (uint8_t row, uint8_t col);
+static uint8_t          main_layers_resolve_layer (uint8_t row, uint8_t col);
+static void             main_exec_function        (void_funptr_t key_function);
+
+// ----------------------------------------------------------------------------
+
+static void main_update_leds(void) {
+	if (keyboard_leds & (1<<0)) { kb_led_num_on(); }
+	else { kb_led_num_off(); }
+	if (keyboard_leds & (1<<1)) { kb_led_caps_on(); }
+	else { kb_led_caps_off(); }
+	if (keyboard_leds & (1<<2)) { kb_led_scroll_on(); }
+	else { kb_led_scroll_off(); }
+	if (keyboard_leds & (1<<3)) { kb_led_compose_on(); }
+	else { kb_led_compose_off(); }
+	if (keyboard_leds & (1<<4)) { kb_led_kana_on(); }
+	else { kb_led_kana_off(); }
+}
+
+// send the USB reports, if anything's changed
+// - they're queued, and go out one per host poll, in the order sent (see
+//   "usb_keyboard.c")
+// - returns whether they all were (a report is refused if its queue is full,
+//   and stays dirty)
+static bool main_send_reports(void) {
+	if (keyboard_report_dirty)
+		usb_keyboard_send();
+	if (consumer_report_dirty)
+		usb_extra_consumer_send();
+	if (system_report_dirty)
+		usb_extra_system_send();
+
+	return !( keyboard_report_dirty
+	       || consumer_report_dirty
+	       || system_report_dirty );
+}
+
+/*
+ * Handle a change in the state of the key at 'r', 'c' (from
+ * `main_kb_was_pressed` to `main_kb_is_pressed`): "execute" it, and record
+ * that it's been handled
+ *
+ * Notes
+ * - An event is only handled if every report so far has been queued, and
+ *   there's room in the queues for what it might send.  If not (the host
+ *   isn't reading them), `main_kb_pending` is set, and `main()` leaves the
+ *   rest of the events for a later scan, by setting `main_kb_is_pressed` back
+ *   to the state that's been handled.  So no report is lost, and the host
+ *   never sees half of a press/release pair; though a key that goes down and
+ *   back up entirely while events are waiting isn't seen at all.
+ */
+static void main_kb_event(uint8_t r, uint8_t c) {
+	if (main_kb_pending || usb_report_queue_room() < REPORT_ROOM) {
+		main_kb_pending = true;
+		return;
+	}
+
+	main_arg_is_pressed   = ((*main_kb_is_pressed)[r] >> c) & 1;
+	main_arg_was_pressed  = !main_arg_is_pressed;
+	main_arg_row          = r;
+	main_arg_col          = c;
+	main_arg_layer_offset = 0;
+
+	// presses go straight to the function that transparent keys (if any)
+	// would have led to (see `main_layers_resolve()`)
+	if (main_arg_is_pressed) {
+		main_exec_function(main_layers_resolve(r, c));
+	} else {
+		main_arg_layer = main_layers_pressed[r][c];
+		main_arg_trans_key_pressed = main_kb_was_transparent[r][c];
+		main_exec_key();
+	}
+	main_kb_was_transparent[r][c] = main_arg_trans_key_pressed;
+	(*main_kb_was_pressed)[r] ^= (1U<<c);
+
+	if (REPORT_PER_EVENT)
+		main_kb_pending = !main_send_reports();
+}
+
+/*
+ * Before the key at 'r', 'c' is pressed, release any key after it (in matrix
+ * order) that's being released this scan, and has the same action (keycode
+ * and press function) as it will have
+ */
+static void main_kb_release_same(uint8_t r, uint8_t c) {
+	uint8_t       layer   = main_layers_resolve_layer(r, c);
+	uint8_t       keycode = kb_layout_get(layer, r, c);
+	void_funptr_t press   = kb_layout_press_get(layer, r, c);
+
+	for (uint8_t r2=r; r2<KB_ROWS; r2++) {
+		uint16_t released = (*main_kb_was_pressed)[r2]
+		                  & ~(*main_kb_is_pressed)[r2];
+		if (r2 == r)
+			released &= ~((2U<<c)-1);
+
+		for (uint8_t c2=0; released; c2++, released >>= 1) {
+			if (!(released & 1))
+				continue;
+			uint8_t layer2 = main_layers_pressed[r2][c2];
+			if ( kb_layout_get(layer2, r2, c2) == keycode
+			  && kb_layout_press_get(layer2, r2, c2) == press )
+				main_kb_event(r2, c2);
+		}
+	}
+}
+
+/*
+ * Wait out a USB suspend, in power-down sleep, waking every ~32 ms to check
+ * whether a key is down (and if one is, asking the host to wake up)
+ *
+ * Notes
+ * - Returns once the host resumes the bus (or resets it); scanning starts
+ *   again from scratch (not idle), so the key that woke the host is seen
+ */
+static void main_suspend(void) {
+	if (main_idle)
+		kb_idle_exit();
+	kb_suspend_enter();
+
+	while (usb_suspended()) {
+		timer_sleep_long();
+		if (kb_suspend_poll())
+			usb_remote_wakeup();
+	}
+
+	kb_suspend_exit();
+	main_idle = false;
+	main_idle_ticks = 0;
+
+	// the ticks counted while we were awake polling aren't missed scans
+	timer_wait_tick();
+}
+
 // ----------------------------------------------------------------------------
 
 /*
@@ -61,13 +237,46 @@ int main(void) {
 
 	kb_led_state_ready();
 
+	timer_init(main_scan_rate);
+
+	main_layers_resolve_all();
+
 	for (;;) {
+		// wait for the next scan tick (sleeping until then), and keep track
+		// of any ticks we were too busy to see
+		main_scan_ticks_missed += timer_wait_tick() - 1;
+
+		// the host has suspended the bus: go to sleep until it's resumed
+		if (usb_suspended()) {
+			main_suspend();
+			continue;
+		}
+
+		// answer the host, if it's asked for anything (over raw HID)
+		telemetry_update();
+
+		// while idle, only check whether a key is down; if one is, go back
+		// to scanning (starting with this tick), and record how long that
+		// took (from the tick, in timer subticks)
+		if (main_idle) {
+			if (!kb_idle_poll()) {
+				main_update_leds();
+				continue;
+			}
+			kb_idle_exit();
+			main_idle = false;
+			main_idle_wake_duration = timer_get_subticks();
+			if (main_idle_wake_duration > main_idle_wake_duration_max)
+				main_idle_wake_duration_max = main_idle_wake_duration;
+		}
+
 		// swap `main_kb_is_pressed` and `main_kb_was_pressed`, then update
-		bool (*temp)[KB_ROWS][KB_COLUMNS] = main_kb_was_pressed;
+		uint16_t (*temp)[KB_ROWS] = main_kb_was_pressed;
 		main_kb_was_pressed = main_kb_is_pressed;
 		main_kb_is_pressed = temp;
 
-		kb_update_matrix(*main_kb_is_pressed);
+		kb_update_matrix(main_kb_raw);
+		bool changed = debounce_update(main_kb_raw, *main_kb_is_pressed);
 
 		// this loop is responsible to
 		// - "execute" keys when they change state
@@ -79,57 +288,100 @@ int main(void) {
 		//   - see the keyboard layout file ("keyboard/ergodox/layout/*.c") for
 		//     which key is assigned which function (per layer)
 		//   - see "lib/key-functions/public/*.c" for the function definitions
-		#define row          main_loop_row
-		#define col          main_loop_col
-		#define layer        main_arg_layer
-		#define is_pressed   main_arg_is_pressed
-		#define was_pressed  main_arg_was_pressed
-		for (row=0; row<KB_ROWS; row++) {
-			for (col=0; col<KB_COLUMNS; col++) {
-				is_pressed = (*main_kb_is_pressed)[row][col];
-				was_pressed = (*main_kb_was_pressed)[row][col];
-
-				if (is_pressed != was_pressed) {
-					if (is_pressed) {
-						layer = main_layers_peek(0);
-						main_layers_pressed[row][col] = layer;
-						main_arg_trans_key_pressed = false;
-					} else {
-						layer = main_layers_pressed[row][col];
-						main_arg_trans_key_pressed = main_kb_was_transparent[row][col];
-					}
-
-					// set remaining vars, and "execute" key
-					main_arg_row          = row;
-					main_arg_col          = col;
-					main_arg_layer_offset = 0;
-					main_exec_key();
-					main_kb_was_transparent[row][col] = main_arg_trans_key_pressed;
+		// - changed keys are found by XORing the rows; on a scan where
+		//   nothing changed (the usual case) none of this runs
+		// - keys changing in the same scan are handled in matrix order (the
+		//   order they're found in).  they changed within one scan period of
+		//   each other, and there's no finer timestamp to go by (each half
+		//   is read all at once), so that order is as good as any; and it
+		//   doesn't favor presses or releases.  the exception: a key being
+		//   released with the same action as one being pressed (e.g. a roll
+		//   between two Tab keys) is released first, so the host doesn't see
+		//   it go up while the other is held (see "makefile-options")
+		// - with `REPORT_PER_EVENT`, each event gets its own report, so the
+		//   host sees them in this order too, instead of all at once
+		// - see `main_kb_event()` for what happens to events while the host
+		//   isn't reading reports
+		#define row  main_loop_row
+		#define col  main_loop_col
+		if (changed || main_kb_pending) {
+			main_kb_pending = !main_send_reports();  // refused earlier
+
+			for (row=0; !main_kb_pending && row<KB_ROWS; row++) {
+				if (!( (*main_kb_is_pressed)[row]
+				     ^ (*main_kb_was_pressed)[row] ))
+					continue;
+
+				for (col=0; !main_kb_pending && col<KB_COLUMNS; col++) {
+					uint16_t bit = (1U<<col);
+					if (!( ( (*main_kb_is_pressed)[row]
+					       ^ (*main_kb_was_pressed)[row] ) & bit ))
+						continue;
+
+					if ((*main_kb_is_pressed)[row] & bit)
+						main_kb_release_same(row, col);
+					main_kb_event(row, col);
 				}
 			}
+
+			if (main_kb_pending)
+				for (row=0; row<KB_ROWS; row++)
+					(*main_kb_is_pressed)[row] = (*main_kb_was_pressed)[row];
 		}
 		#undef row
 		#undef col
-		#undef layer
-		#undef is_pressed
-		#undef was_pressed
 
-		// send the USB report (even if nothing's changed)
-		usb_keyboard_send();
-		usb_extra_consumer_send();
-		_delay_ms(MAKEFILE_DEBOUNCE_TIME);
+		// send the USB reports, if anything's changed (and hasn't been
+		// sent already)
+		// - the host is sent repeats of the keyboard report (at the idle
+		//   rate it asked for) by "usb_keyboard.c"
+		main_send_reports();
 
 		// update LEDs
-		if (keyboard_leds & (1<<0)) { kb_led_num_on(); }
-		else { kb_led_num_off(); }
-		if (keyboard_leds & (1<<1)) { kb_led_caps_on(); }
-		else { kb_led_caps_off(); }
-		if (keyboard_leds & (1<<2)) { kb_led_scroll_on(); }
-		else { kb_led_scroll_off(); }
-		if (keyboard_leds & (1<<3)) { kb_led_compose_on(); }
-		else { kb_led_compose_off(); }
-		if (keyboard_leds & (1<<4)) { kb_led_kana_on(); }
-		else { kb_led_kana_off(); }
+		main_update_leds();
+
+		// go idle, after `IDLE_TICKS` scans with nothing down (raw or
+		// debounced)
+		{
+			uint16_t any = 0;
+			for (uint8_t row=0; row<KB_ROWS; row++)
+				any |= main_kb_raw[row] | (*main_kb_is_pressed)[row];
+
+			if (any || !IDLE_TICKS)
+				main_idle_ticks = 0;
+			else if (++main_idle_ticks >= IDLE_TICKS) {
+				kb_idle_enter();
+				main_idle = true;
+				main_idle_ticks = 0;
+			}
+		}
+
+		// record how long this pass took (from the tick, in timer subticks)
+		main_scan_duration = timer_get_subticks();
+		if (main_scan_duration > main_scan_duration_max)
+			main_scan_duration_max = main_scan_duration;
+
+		// lock to every Nth USB frame, with N frames per tick (if N is a
+		// whole number); checked again whenever the scan rate changes
+		if (main_scan_rate != main_sync_rate) {
+			main_sync_rate = main_scan_rate;
+			main_sync_lead = 0;
+			usb_frames_per_sync = ( 1000 % main_scan_rate )
+					      ? 0 : 1000 / main_scan_rate;
+		}
+
+		// start scans early enough that the slowest recent one would still
+		// finish (plus a margin) before the USB frame they're locked to;
+		// this follows a slower scan right away, and a faster one only
+		// gradually (so one quick pass doesn't let the next slow one miss
+		// its frame)
+		if (SOF_SYNC) {
+			if (main_scan_duration > main_sync_lead)
+				main_sync_lead = main_scan_duration;
+			else
+				main_sync_lead -= (main_sync_lead - main_scan_duration) >> 8;
+			timer_sync(main_sync_lead + SOF_SYNC_MARGIN);
+		}
 	}
 
 	return 0;
@@ -153,41 +405,168 @@ int main(void) {
  * may appear in the stack more than once.  The base layer will always be
  * layer-0.  
  *
- * Implemented as a fixed size stack.
+ * Implemented as a doubly linked list of elements, one slot per id, from the
+ * top of the stack down to the base element (id 0, which is never popped);
+ * plus a stack of ids that have been freed, and a count (and bitmap) of the
+ * elements on each layer.  So push, pop, peek(0), and "is this layer active"
+ * are all constant time, no matter how deep the stack is.  Peeking further
+ * down costs one step per element, but a peek at the offset just after the
+ * last one (as with transparent keys) continues from where that one left
+ * off.
+ *
+ * For each key, the element its press would end up on (looking through any
+ * transparent keys above it), and the press function there, are kept in RAM,
+ * and updated whenever an element is pushed or popped; so a keypress is
+ * dispatched with one lookup, no matter how many transparent layers there
+ * are (see `main_layers_resolve()`).
  * ------------------------------------------------------------------------- */
 
+#if MAX_ACTIVE_LAYERS > 0xFF
+	#error "MAX_ACTIVE_LAYERS must fit in a uint8_t"
+#endif
+
 // ----------------------------------------------------------------------------
 
 struct layers {
 	uint8_t layer;
-	uint8_t id;
 	uint8_t sticky;
+	uint8_t up;    // the id of the element above this one (0 if none)
+	uint8_t down;  // the id of the element below this one
+	bool    in_use;
 };
 
 // ----------------------------------------------------------------------------
 
-struct layers layers[MAX_ACTIVE_LAYERS];
-uint8_t       layers_head = 0;
-uint8_t       layers_ids_in_use[MAX_ACTIVE_LAYERS] = {true};
+static struct layers layers[MAX_ACTIVE_LAYERS] = { [0] = { .in_use = true } };
+static uint8_t       layers_top;  // the id of the top element
+
+static uint8_t layers_free[MAX_ACTIVE_LAYERS-1];  // ids that have been popped
+static uint8_t layers_free_count;
+static uint8_t layers_never_used = 1;  // ids from here up haven't been used
+
+static uint8_t layers_count[KB_LAYERS] = { [0] = 1 };  // elements, per layer
+static uint8_t layers_active[(KB_LAYERS+7)/8] = { [0] = 1 };  // bitmap
+
+// the last element found by `main_layers_peek*()`
+static uint8_t layers_peek_offset, layers_peek_id;
+
+// for each key: the first element (from the top) where its press function
+// isn't `kbfun_transparent`, and that function
+static struct {
+	uint8_t       id;
+	void_funptr_t press;
+} layers_resolved[KB_ROWS][KB_COLUMNS];
 
 /*
- * Exec key
- * - Execute the keypress or keyrelease function (if it exists) of the key at
- *   the current possition.
+ * Returns
+ * - the id of the element at 'offset' down the stack from the top, or
+ *   `MAX_ACTIVE_LAYERS` if there isn't one
  */
-void main_exec_key(void) {
-	void (*key_function)(void) =
-		( (is_pressed)
-		  ? kb_layout_press_get(layer, row, col)
-		  : kb_layout_release_get(layer, row, col) );
+static uint8_t layers_find(uint8_t offset) {
+	uint8_t id = layers_top;
+	uint8_t n  = offset;
+
+	if (offset == layers_peek_offset+1 && layers_peek_id) {
+		id = layers_peek_id;
+		n  = 1;
+	}
+	for (; n; n--) {
+		if (!id)
+			return MAX_ACTIVE_LAYERS;
+		id = layers[id].down;
+	}
 
+	layers_peek_offset = offset;
+	layers_peek_id     = id;
+	return id;
+}
+
+/*
+ * Find where the key at 'r', 'c' resolves to, starting at element 'id' and
+ * going down, and remember it
+ * - the base element is as far as we go, even if it's transparent there
+ */
+static void layers_resolve_from(uint8_t r, uint8_t c, uint8_t id) {
+	void_funptr_t press;
+
+	for (;;) {
+		press = kb_layout_press_get(layers[id].layer, r, c);
+		if (!id || press != &kbfun_transparent)
+			break;
+		id = layers[id].down;
+	}
+
+	layers_resolved[r][c].id    = id;
+	layers_resolved[r][c].press = press;
+}
+
+/*
+ * Resolve every key, from the top of the stack
+ * - must be called once, before any keys are pressed (and again whenever
+ *   more than a few elements change at once)
+ */
+static void main_layers_resolve_all(void) {
+	for (uint8_t r=0; r<KB_ROWS; r++)
+		for (uint8_t c=0; c<KB_COLUMNS; c++)
+			layers_resolve_from(r, c, layers_top);
+}
+
+/*
+ * resolve()
+ *
+ * Arguments
+ * - 'row', 'col': the key being pressed
+ *
+ * Returns
+ * - the press function to execute; the same one `kbfun_transparent()` would
+ *   eventually have got to
+ *
+ * Notes
+ * - Sets `main_arg_layer`, `main_layers_pressed[row][col]`, and
+ *   `main_arg_trans_key_pressed`, as `kbfun_transparent()` would have
+ */
+static void_funptr_t main_layers_resolve(uint8_t r, uint8_t c) {
+	uint8_t id = layers_resolved[r][c].id;
+
+	layer = layers[id].layer;
+	main_layers_pressed[r][c] = layer;
+	main_arg_trans_key_pressed = (id != layers_top);
+
+	return layers_resolved[r][c].press;
+}
+
+/*
+ * Returns
+ * - the layer the key at 'r', 'c' would be on, if it were pressed now (what
+ *   `main_layers_resolve()` would set `main_arg_layer` to)
+ */
+static uint8_t main_layers_resolve_layer(uint8_t r, uint8_t c) {
+	return layers[layers_resolved[r][c].id].layer;
+}
+
+/*
+ * Execute a key function, and then pop the top layer if it's "sticky once
+ * up" and this was the key it was waiting for
+ */
+static void main_exec_function(void_funptr_t key_function) {
 	if (key_function)
 		(*key_function)();
 
 	// If the current layer is in the sticky once up state and a key defined
 	//  for this layer (a non-transparent key) was pressed, pop the layer
-	if (layers[layers_head].sticky == eStickyOnceUp && main_arg_any_non_trans_key_pressed)
-		main_layers_pop_id(layers_head);
+	if (layers[layers_top].sticky == eStickyOnceUp && main_arg_any_non_trans_key_pressed)
+		main_layers_pop_id(layers_top);
+}
+
+/*
+ * Exec key
+ * - Execute the keypress or keyrelease function (if it exists) of the key at
+ *   the current possition.
+ */
+void main_exec_key(void) {
+	main_exec_function( (is_pressed)
+			    ? kb_layout_press_get(layer, row, col)
+			    : kb_layout_release_get(layer, row, col) );
 }
 
 /*
@@ -201,19 +580,59 @@ void main_exec_key(void) {
  * - failure: 0 (default) (out of bounds)
  */
 uint8_t main_layers_peek(uint8_t offset) {
-	if (offset <= layers_head)
-		return layers[layers_head - offset].layer;
+	uint8_t id = layers_find(offset);
+	if (id < MAX_ACTIVE_LAYERS)
+		return layers[id].layer;
 
 	return 0;  // default, or error
 }
 
 uint8_t main_layers_peek_sticky(uint8_t offset) {
-	if (offset <= layers_head)
-		return layers[layers_head - offset].sticky;
+	uint8_t id = layers_find(offset);
+	if (id < MAX_ACTIVE_LAYERS)
+		return layers[id].sticky;
 
 	return 0;  // default, or error
 }
 
+/*
+ * is_active()
+ *
+ * Arguments
+ * - 'layer': a layer-number
+ *
+ * Returns
+ * - whether any element of the stack is on that layer (layer-0 always is)
+ */
+bool main_layers_is_active(uint8_t layer) {
+	if (layer < KB_LAYERS)
+		return layers_active[layer/8] & (1<<(layer%8));
+
+	return false;
+}
+
+/*
+ * has_id()
+ *
+ * Arguments
+ * - 'id': the id of an element
+ * - 'layer': a layer-number
+ *
+ * Returns
+ * - whether that element is on the stack, and on that layer
+ *
+ * Notes
+ * - Popped ids are given out again (the most recently popped first), so an id
+ *   kept since it was pushed may by now belong to some other element; this is
+ *   how to tell
+ */
+bool main_layers_has_id(uint8_t id, uint8_t layer) {
+	if (!id || id >= MAX_ACTIVE_LAYERS)
+		return false;
+
+	return layers[id].in_use && layers[id].layer == layer;
+}
+
 /*
  * push()
  *
@@ -225,20 +644,40 @@ uint8_t main_layers_peek_sticky(uint8_t offset) {
  * - failure: 0 (the stack was already full)
  */
 uint8_t main_layers_push(uint8_t layer, uint8_t sticky) {
-	// look for an available id
-	for (uint8_t id=1; id<MAX_ACTIVE_LAYERS; id++) {
-		// if one is found
-		if (layers_ids_in_use[id] == false) {
-			layers_ids_in_use[id] = true;
-			layers_head++;
-			layers[layers_head].layer = layer;
-			layers[layers_head].id = id;
-			layers[layers_head].sticky = sticky;
-			return id;
+	uint8_t id;
+
+	// get an available id
+	if (layers_free_count)
+		id = layers_free[--layers_free_count];
+	else if (layers_never_used < MAX_ACTIVE_LAYERS)
+		id = layers_never_used++;
+	else
+		return 0;  // default, or error
+
+	layers[id].layer  = layer;
+	layers[id].sticky = sticky;
+	layers[id].up     = 0;
+	layers[id].down   = layers_top;
+	layers[id].in_use = true;
+	layers[layers_top].up = id;
+	layers_top = id;
+
+	if (layer < KB_LAYERS && !layers_count[layer]++)
+		layers_active[layer/8] |= (1<<(layer%8));
+
+	// keys that aren't transparent on the new top element resolve to it;
+	// the rest stay as they were
+	for (uint8_t r=0; r<KB_ROWS; r++)
+		for (uint8_t c=0; c<KB_COLUMNS; c++) {
+			void_funptr_t press = kb_layout_press_get(layer, r, c);
+			if (press != &kbfun_transparent) {
+				layers_resolved[r][c].id    = id;
+				layers_resolved[r][c].press = press;
+			}
 		}
-	}
 
-	return 0;  // default, or error
+	layers_peek_id = 0;  // offsets have changed
+	return id;
 }
 
 /*
@@ -248,22 +687,61 @@ uint8_t main_layers_push(uint8_t layer, uint8_t sticky) {
  * - 'id': the id of the element to pop from the stack
  */
 void main_layers_pop_id(uint8_t id) {
-	// look for the element with the id we want to pop
-	for (uint8_t element=1; element<=layers_head; element++)
-		// if we find it
-		if (layers[element].id == id) {
-			// move all layers above it down one
-			for (; element<layers_head; element++) {
-				layers[element].layer = layers[element+1].layer;
-				layers[element].id = layers[element+1].id;
-			}
-			// reinitialize the topmost (now unused) slot
-			layers[layers_head].layer = 0;
-			layers[layers_head].id = 0;
-			// record keeping
-			layers_ids_in_use[id] = false;
-			layers_head--;
-		}
+	if (!id || id >= MAX_ACTIVE_LAYERS || !layers[id].in_use)
+		return;
+
+	// unlink it
+	uint8_t up   = layers[id].up;
+	uint8_t down = layers[id].down;
+	layers[down].up = up;
+	if (up)
+		layers[up].down = down;
+	else
+		layers_top = down;
+
+	// record keeping
+	uint8_t number = layers[id].layer;
+	if (number < KB_LAYERS && !--layers_count[number])
+		layers_active[number/8] &= ~(1<<(number%8));
+
+	// only keys that resolved to this element change; everything above it
+	// was transparent for them, so carry on from the one below
+	for (uint8_t r=0; r<KB_ROWS; r++)
+		for (uint8_t c=0; c<KB_COLUMNS; c++)
+			if (layers_resolved[r][c].id == id)
+				layers_resolve_from(r, c, down);
+
+	layers[id].in_use = false;
+	layers_free[layers_free_count++] = id;
+	layers_peek_id = 0;  // offsets have changed
+}
+
+/*
+ * pop_all()
+ *
+ * Pop every element but the base one
+ *
+ * Notes
+ * - Every key is resolved again, once; rather than once per element popped
+ * - All ids become unassigned (so any still being kept elsewhere are stale)
+ */
+void main_layers_pop_all(void) {
+	for (uint8_t id=1; id<MAX_ACTIVE_LAYERS; id++)
+		layers[id].in_use = false;
+	layers[0].up      = 0;
+	layers_top        = 0;
+	layers_free_count = 0;
+	layers_never_used = 1;
+
+	for (uint8_t number=0; number<KB_LAYERS; number++)
+		layers_count[number] = 0;
+	for (uint8_t i=0; i<sizeof(layers_active); i++)
+		layers_active[i] = 0;
+	layers_count[0]  = 1;
+	layers_active[0] = 1;
+
+	main_layers_resolve_all();
+	layers_peek_id = 0;  // offsets have changed
 }
 
 /*
@@ -276,16 +754,20 @@ void main_layers_pop_id(uint8_t id) {
  * - success: the offset (down the stack from the head element) of the element
  *   with the given id
  * - failure: 0 (default) (id unassigned)
+ *
+ * Note
+ * - Walks down the stack (there's nothing that stays constant when elements
+ *   below are popped to go by); nothing calls this while keys are processed
  */
 uint8_t main_layers_get_offset_id(uint8_t id) {
-	// look for the element with the id we want to get the offset of
-	for (uint8_t element=1; element<=layers_head; element++)
-		// if we find it
-		if (layers[element].id == id)
-			return (layers_head - element);
+	if (!id || id >= MAX_ACTIVE_LAYERS || !layers[id].in_use)
+		return 0;  // default, or error
 
-	return 0;  // default, or error
+	uint8_t offset = 0;
+	for (uint8_t element=layers_top; element!=id; element=layers[element].down)
+		offset++;
 
+	return offset;
 }
 
 /* ----------------------------------------------------------------------------
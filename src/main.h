@@ -24,8 +24,8 @@
 		eStickyLock
 	} StickyState;
 
-	extern bool (*main_kb_is_pressed)[KB_ROWS][KB_COLUMNS];
-	extern bool (*main_kb_was_pressed)[KB_ROWS][KB_COLUMNS];
+	extern uint16_t (*main_kb_is_pressed)[KB_ROWS];
+	extern uint16_t (*main_kb_was_pressed)[KB_ROWS];
 
 	extern uint8_t main_layers_pressed[KB_ROWS][KB_COLUMNS];
 
@@ -41,14 +41,31 @@
 	extern bool    main_arg_any_non_trans_key_pressed;
 	extern bool    main_arg_trans_key_pressed;
 
+	// in Hz (may be changed at runtime; see "telemetry.c")
+	extern uint16_t main_scan_rate;
+
+	// in timer subticks (see "lib/timer.h"), from the start of the tick
+	extern uint16_t main_scan_duration;
+	extern uint16_t main_scan_duration_max;
+	extern uint16_t main_scan_ticks_missed;
+
+	// whether we're idle (not scanning; see `kb_idle_*()`), and how long the
+	// last wake up took, in timer subticks from the start of the tick
+	extern bool     main_idle;
+	extern uint16_t main_idle_wake_duration;
+	extern uint16_t main_idle_wake_duration_max;
+
 	// --------------------------------------------------------------------
 
 	void main_exec_key (void);
 
 	uint8_t main_layers_peek          (uint8_t offset);
 	uint8_t main_layers_peek_sticky   (uint8_t offset);
+	bool    main_layers_is_active     (uint8_t layer);
+	bool    main_layers_has_id        (uint8_t id, uint8_t layer);
 	uint8_t main_layers_push          (uint8_t layer, uint8_t sticky);
 	void    main_layers_pop_id        (uint8_t id);
+	void    main_layers_pop_all       (void);
 	uint8_t main_layers_get_offset_id (uint8_t id);
 
 
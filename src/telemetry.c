@@ -0,0 +1,226 @@
+/* ----------------------------------------------------------------------------
+ * Telemetry and runtime settings (over raw HID) : code
+ *
+ * The host sends a request (one raw HID report), and gets back exactly one
+ * response.  All multi-byte values are little endian.
+ *
+ * Requests
+ * - byte 0: the command (`TELEMETRY_...`)
+ * - bytes 1..: arguments, if any
+ *
+ * Responses
+ * - byte 0: the command being answered
+ * - byte 1: the status (`TELEMETRY_OK`, or an error)
+ * - bytes 2..: the result, if any
+ *
+ * Commands
+ * - PING: returns the protocol version (uint8)
+ * - GET_COUNTERS: returns (uint16 unless noted)
+ *   - subticks per us (uint8; for converting the durations below)
+ *   - scan rate (Hz), scan duration, scan duration max, scan ticks missed
+ *   - idle (uint8), idle wake duration, idle wake duration max
+ *   - USB frame sync phase error (int16, in subticks)
+ *   - TWI errors: timeout, recovered, sla nack, data nack, arbitration, other
+ *   - USB reports sent, reports per second, report overflows (times a
+ *     queue was full, and reports had to wait)
+ *   - USB report queue depth (uint8)
+ * - CLEAR_COUNTERS: resets the maxima, missed ticks, and error counts
+ * - GET_SETTINGS: returns debounce time (ms, uint8), debounce mode (uint8),
+ *   scan rate (Hz, uint16), LED brightness (uint8)
+ * - SET_SETTING: takes a setting (`TELEMETRY_...`, uint8) and a value
+ *   (uint16); returns nothing.  Settings are lost on reset.
+ *
+ * Notes
+ * - Durations are in timer subticks (see "lib/timer.h")
+ * - Requests are handled from the main loop, at most one per scan, so they
+ *   don't add more than a few us to any scan.  If the host hasn't read the
+ *   last response yet, new requests wait.
+ * - "build-scripts/telemetry.py" is a client for this (on Linux)
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2026 The ergodox-firmware contributors
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <avr/interrupt.h>
+#include "./lib-other/pjrc/usb_keyboard/usb_keyboard.h"
+#include "./lib/debounce.h"
+#include "./lib/timer.h"
+#include "./lib/twi.h"
+#include "./keyboard/controller.h"
+#include "./main.h"
+#include "./telemetry.h"
+
+// ----------------------------------------------------------------------------
+
+// settings that aren't kept elsewhere in a usable form
+static uint8_t _debounce_time  = MAKEFILE_DEBOUNCE_TIME;
+static uint8_t _led_brightness = (uint8_t)(MAKEFILE_LED_BRIGHTNESS * 0xFF);
+
+static uint8_t _buffer[RAWHID_SIZE];
+static bool    _pending;  // whether `_buffer` holds a response not yet sent
+
+// ----------------------------------------------------------------------------
+
+static uint8_t * _put8(uint8_t * p, uint8_t value) {
+	*p++ = value;
+	return p;
+}
+
+static uint8_t * _put16(uint8_t * p, uint16_t value) {
+	*p++ = value & 0xFF;
+	*p++ = value >> 8;
+	return p;
+}
+
+// ----------------------------------------------------------------------------
+
+static void _get_counters(uint8_t * p) {
+	// with interrupts off, so that the counters (some of which are updated
+	// from ISRs) are all from the same moment
+	uint8_t sreg = SREG;
+	cli();
+
+	p = _put8  (p, TIMER_SUBTICKS_PER_US);
+	p = _put16 (p, main_scan_rate);
+	p = _put16 (p, main_scan_duration);
+	p = _put16 (p, main_scan_duration_max);
+	p = _put16 (p, main_scan_ticks_missed);
+	p = _put8  (p, main_idle);
+	p = _put16 (p, main_idle_wake_duration);
+	p = _put16 (p, main_idle_wake_duration_max);
+	p = _put16 (p, timer_get_sync_error());
+	p = _put16 (p, twi_errors.timeout);
+	p = _put16 (p, twi_errors.recovered);
+	p = _put16 (p, twi_errors.sla_nack);
+	p = _put16 (p, twi_errors.data_nack);
+	p = _put16 (p, twi_errors.arbitration);
+	p = _put16 (p, twi_errors.other);
+	p = _put16 (p, usb_reports_sent);
+	p = _put16 (p, usb_report_rate);
+	p = _put16 (p, usb_report_overflows);
+	p = _put8  (p, usb_report_queue_depth());
+
+	SREG = sreg;
+}
+
+static void _clear_counters(void) {
+	uint8_t sreg = SREG;
+	cli();
+
+	main_scan_duration_max      = 0;
+	main_scan_ticks_missed      = 0;
+	main_idle_wake_duration_max = 0;
+	memset(&twi_errors, 0, sizeof(twi_errors));
+	usb_report_overflows        = 0;
+
+	SREG = sreg;
+}
+
+static void _get_settings(uint8_t * p) {
+	p = _put8  (p, _debounce_time);
+	p = _put8  (p, debounce_mode);
+	p = _put16 (p, main_scan_rate);
+	p = _put8  (p, _led_brightness);
+}
+
+/*
+ * Returns
+ * - the status
+ */
+static uint8_t _set_setting(uint8_t setting, uint16_t value) {
+	switch (setting) {
+		case TELEMETRY_DEBOUNCE_TIME:
+			if ( value > 0xFF
+			  || DEBOUNCE_MS_TO_TICKS(value, main_scan_rate) > 0xFF )
+				return TELEMETRY_OUT_OF_RANGE;
+			_debounce_time = value;
+			debounce_ticks = DEBOUNCE_MS_TO_TICKS(value, main_scan_rate);
+			return TELEMETRY_OK;
+
+		case TELEMETRY_DEBOUNCE_MODE:
+			if (value != DEBOUNCE_EAGER && value != DEBOUNCE_DEFERRED)
+				return TELEMETRY_OUT_OF_RANGE;
+			debounce_mode = value;
+			return TELEMETRY_OK;
+
+		// - other times set in ms at compile time (the idle timeout, the
+		//   left hand reconnect backoff) are still counted in scans, so
+		//   they'll be shorter or longer by the same factor
+		// - syncing to USB frames only happens at rates that divide 1000
+		//   (100, 125, 200, 250, 500, or 1000 Hz)
+		case TELEMETRY_SCAN_RATE:
+			if ( value < 100 || value > 2000
+			  || DEBOUNCE_MS_TO_TICKS(_debounce_time, value) > 0xFF )
+				return TELEMETRY_OUT_OF_RANGE;
+			main_scan_rate = value;
+			timer_set_frequency(value);
+			debounce_ticks = DEBOUNCE_MS_TO_TICKS(_debounce_time, value);
+			return TELEMETRY_OK;
+
+		case TELEMETRY_LED_BRIGHTNESS:
+			if (value > 0xFF)
+				return TELEMETRY_OUT_OF_RANGE;
+			_led_brightness = value;
+			_kb_led_all_set(value);
+			return TELEMETRY_OK;
+	}
+
+	return TELEMETRY_UNKNOWN_SETTING;
+}
+
+// ----------------------------------------------------------------------------
+
+/*
+ * Handle (at most) one request from the host, if there is one
+ *
+ * Notes
+ * - Should be called once per scan (including while idle)
+ */
+void telemetry_update(void) {
+	if (_pending) {
+		if (usb_rawhid_send(_buffer))
+			return;
+		_pending = false;
+	}
+
+	if (!usb_rawhid_recv(_buffer))
+		return;
+
+	uint8_t   command = _buffer[0];
+	uint8_t   setting = _buffer[1];
+	uint16_t  value   = _buffer[2] | (_buffer[3] << 8);
+	uint8_t * status  = &_buffer[1];
+	uint8_t * result  = &_buffer[2];
+
+	memset(_buffer+1, 0, RAWHID_SIZE-1);
+	*status = TELEMETRY_OK;
+
+	switch (command) {
+		case TELEMETRY_PING:
+			_put8(result, TELEMETRY_VERSION);
+			break;
+		case TELEMETRY_GET_COUNTERS:
+			_get_counters(result);
+			break;
+		case TELEMETRY_CLEAR_COUNTERS:
+			_clear_counters();
+			break;
+		case TELEMETRY_GET_SETTINGS:
+			_get_settings(result);
+			break;
+		case TELEMETRY_SET_SETTING:
+			*status = _set_setting(setting, value);
+			break;
+		default:
+			*status = TELEMETRY_UNKNOWN_COMMAND;
+			break;
+	}
+
+	_pending = (usb_rawhid_send(_buffer) != 0);
+}
+
@@ -0,0 +1,42 @@
+/* ----------------------------------------------------------------------------
+ * Telemetry and runtime settings (over raw HID) : exports
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2026 The ergodox-firmware contributors
+ * Released under The MIT License (MIT) (see "license.md")
+ * Project located at <https://github.com/benblazak/ergodox-firmware>
+ * ------------------------------------------------------------------------- */
+
+
+#ifndef TELEMETRY_h
+	#define TELEMETRY_h
+
+	// --------------------------------------------------------------------
+
+	// the protocol version (returned by `TELEMETRY_PING`)
+	#define  TELEMETRY_VERSION  1
+
+	// commands (the first byte of a request)
+	#define  TELEMETRY_PING            0x00
+	#define  TELEMETRY_GET_COUNTERS    0x01
+	#define  TELEMETRY_CLEAR_COUNTERS  0x02
+	#define  TELEMETRY_GET_SETTINGS    0x03
+	#define  TELEMETRY_SET_SETTING     0x04
+
+	// settings (for `TELEMETRY_SET_SETTING`)
+	#define  TELEMETRY_DEBOUNCE_TIME   0x00  // in ms
+	#define  TELEMETRY_DEBOUNCE_MODE   0x01  // `DEBOUNCE_EAGER` or `_DEFERRED`
+	#define  TELEMETRY_SCAN_RATE       0x02  // in Hz
+	#define  TELEMETRY_LED_BRIGHTNESS  0x03  // 0..255
+
+	// status (the second byte of a response)
+	#define  TELEMETRY_OK               0x00
+	#define  TELEMETRY_UNKNOWN_COMMAND  0x01
+	#define  TELEMETRY_UNKNOWN_SETTING  0x02
+	#define  TELEMETRY_OUT_OF_RANGE     0x03
+
+	// --------------------------------------------------------------------
+
+	void telemetry_update (void);
+
+#endif
+